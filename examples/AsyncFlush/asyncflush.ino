@@ -0,0 +1,75 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <LCD.h>
+#include <SPITransport.h>
+
+// The hardware SPI transport, sending the screen from the SPI interrupt on AVR boards
+// At 1 MHz the interrupts leave most of the time to loop() during a flush
+SPITransport spi(4, 5, 1000000);
+
+// The LCD instance, sending through the SPI transport, reset on pin 6 and backlight on pin 7
+LCD lcd(spi, 6, 7);
+
+// Set by the flush callback, from the SPI interrupt, once the screen shows the last frame
+volatile bool flushed = true;
+
+// The samples taken, and the frames sent
+unsigned long samples = 0;
+unsigned long frames = 0;
+
+// The last sample drawn, in pixels from the top of the chart
+int last = 20;
+
+// Called when an asynchronous flush completes
+void onFlushed()
+{
+     flushed = true;
+}
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+
+	  // Flushes send a copy of the screen buffer, so drawing goes on while it is sent
+	  lcd.setDoubleBuffered();
+	  lcd.setFlushCallback(onFlushed);
+     }
+}
+
+void loop()
+{
+     char text[15];
+
+     // Sampling is never held up by the screen
+     int sample = 39 - (analogRead(0) * 40L / 1024);
+
+     samples++;
+
+     // Draw the sample into the screen buffer, whether a flush is in progress or not
+     lcd.scroll(-1, 0, 0, 8, 84, 40);
+     lcd.drawLine(82, 8 + last, 83, 8 + sample);
+
+     last = sample;
+
+     // Start sending the next frame once the screen shows the previous one
+     if (flushed) {
+	  sprintf(text, "%lu/%lu", frames, samples);
+	  lcd.fillRect(0, 0, 84, 8, false);
+	  lcd.writeString(text, 0, 0);
+
+	  flushed = false;
+
+	  if (lcd.flushAsync()) {
+	       frames++;
+	  }
+	  else {
+	       flushed = true;
+	  }
+     }
+
+     delay(5);
+}
@@ -0,0 +1,69 @@
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <LCD.h>
+
+// The image of the Bitmap example, run-length encoded with extras/bitmap2rle.py
+// 84 x 48 pixels in 315 bytes of program memory instead of 504 bytes of RAM
+PROGMEM const char bitmap[] = { 0x54, 0x30, 0x8e, 0x00, 0x00, 0xc0, 0x82, 0x60, 0x00, 0xe0, 0x82, 0xc0,
+				 0x05, 0x40, 0x20, 0x80, 0xc0, 0x20, 0x20, 0x87, 0x00, 0x07, 0x80, 0x80,
+				 0x40, 0x00, 0x80, 0x40, 0xe0, 0x60, 0x82, 0xc0, 0x03, 0x40, 0x00, 0x00,
+				 0x60, 0x8d, 0xc0, 0x01, 0x80, 0x80, 0x9e, 0x00, 0x01, 0x01, 0x00, 0x82,
+				 0x20, 0x06, 0x60, 0xfe, 0xff, 0x00, 0x00, 0xff, 0x7f, 0x86, 0x00, 0x09,
+				 0xf0, 0xfc, 0x07, 0x01, 0x00, 0xfe, 0xff, 0x00, 0x00, 0xff, 0x87, 0x00,
+				 0x82, 0x80, 0x0e, 0xf8, 0xfe, 0x02, 0x01, 0xfe, 0x01, 0x00, 0xff, 0x20,
+				 0x40, 0x40, 0x41, 0x23, 0xff, 0xfc, 0x9e, 0x00, 0x34, 0x40, 0x41, 0x21,
+				 0x31, 0x17, 0x19, 0x1c, 0x1b, 0x19, 0x38, 0x38, 0x70, 0x20, 0x20, 0x10,
+				 0x00, 0x00, 0x01, 0x07, 0x1f, 0x1c, 0x3c, 0x73, 0x70, 0x60, 0x60, 0x7f,
+				 0x60, 0x20, 0x20, 0x10, 0x08, 0x04, 0x00, 0x41, 0xa0, 0x11, 0x4f, 0x67,
+				 0x33, 0x30, 0x3c, 0x33, 0x30, 0x30, 0x3f, 0x32, 0x71, 0x71, 0x61, 0x22,
+				 0x3f, 0x1f, 0x97, 0x00, 0x04, 0x80, 0x40, 0x40, 0x20, 0xa0, 0x82, 0x20,
+				 0x01, 0x40, 0xc0, 0x82, 0x00, 0x05, 0x20, 0xe0, 0x20, 0x00, 0xc0, 0xa0,
+				 0x82, 0x20, 0x00, 0xe0, 0x82, 0x40, 0x04, 0x50, 0x30, 0x20, 0xe0, 0x20,
+				 0x84, 0x00, 0x02, 0x80, 0xe0, 0x20, 0x87, 0x00, 0x0b, 0x80, 0x40, 0x40,
+				 0x20, 0xe0, 0x00, 0x00, 0xc0, 0x80, 0x80, 0x40, 0x40, 0x82, 0x20, 0x02,
+				 0x60, 0xc0, 0x80, 0x92, 0x00, 0x0a, 0xc3, 0xc2, 0x00, 0xff, 0x00, 0x0c,
+				 0x0a, 0x0a, 0x06, 0x85, 0x78, 0x82, 0x00, 0x00, 0xff, 0x86, 0x00, 0x00,
+				 0xff, 0x84, 0x00, 0x17, 0xf8, 0x07, 0x01, 0x1e, 0x24, 0x28, 0x1e, 0x01,
+				 0x00, 0x07, 0xf8, 0x00, 0x00, 0x0e, 0x0e, 0x01, 0x01, 0xf9, 0x07, 0x02,
+				 0x02, 0x04, 0x18, 0xff, 0x83, 0x00, 0x02, 0xff, 0x00, 0x30, 0x82, 0x40,
+				 0x02, 0x20, 0x10, 0x0f, 0x92, 0x00, 0x01, 0x01, 0x02, 0x82, 0x05, 0x04,
+				 0x04, 0x04, 0x02, 0x03, 0x01, 0x82, 0x00, 0x82, 0x01, 0x84, 0x00, 0x82,
+				 0x01, 0x82, 0x00, 0x01, 0x01, 0x01, 0x88, 0x00, 0x01, 0x01, 0x01, 0x84,
+				 0x00, 0x01, 0x03, 0x0c, 0x82, 0x00, 0x82, 0x01, 0x03, 0x00, 0x0c, 0x08,
+				 0x07, 0x90, 0x00 };
+
+// The LCD instance
+LCD lcd;
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+     }
+}
+
+void loop()
+{
+     // Decode the bitmap into the screen buffer
+     lcd.drawBitmapRLE(bitmap, 0, 0);
+     lcd.flush();
+
+     delay(1500);
+
+     // Decode it lower on the screen, and inverted
+     lcd.clear();
+     lcd.drawBitmapRLE(bitmap, 0, 12, 1, true);
+     lcd.flush();
+
+     delay(1500);
+
+     // Decode it straight to the screen, without going through the screen buffer
+     lcd.drawBitmapRLEDirect(bitmap, 0, 0);
+
+     delay(1500);
+
+     lcd.clear();
+}
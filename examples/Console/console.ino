@@ -0,0 +1,34 @@
+#include <Arduino.h>
+#include <LCD.h>
+#include <Console.h>
+
+// The LCD instance
+LCD lcd;
+
+// The console printing to it, 14 characters on each of 6 lines
+Console console(lcd);
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default), flushing automatically (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight
+	  lcd.setBacklight();
+     }
+
+     console.println("LOG START");
+}
+
+int count = 0;
+
+void loop()
+{
+     // Print a line like to Serial, the screen scrolls up when the last line is full,
+     // which only clears the new last line of the screen buffer
+     console.print("EVENT ");
+     console.print(count++);
+     console.print(" T=");
+     console.println(millis() / 1000);
+
+     delay(500);
+}
@@ -0,0 +1,48 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <LCD.h>
+#include <SPITransport.h>
+
+// The hardware SPI transport, the LCD clock and output lines must be wired to
+// the SCK (13) and MOSI (11) pins, type and enable stay on pins 4 and 5
+SPITransport spi(4, 5);
+
+// The LCD instance, sending through the SPI transport, reset on pin 6 and backlight on pin 7
+LCD lcd(spi, 6, 7);
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+
+	  // Write text into screen buffer
+	  lcd.writeString("LCD", 24, 8, 2);
+	  lcd.writeString("HARDWARE SPI", 6, 24);
+
+	  // Flush screen buffer
+	  lcd.flush();
+
+	  delay(800);
+
+	  // Clear screen buffer, but don't yet flush
+	  lcd.clear();
+     }
+}
+
+int count = 0;
+
+void loop()
+{
+     char text[12];
+
+     // Full frames are cheap over SPI, so redraw the whole screen every time
+     sprintf(text, "%d", count++);
+
+     lcd.clear();
+     lcd.writeString("FRAME", 0, 0);
+     lcd.writeString(text, 0, 16, 2);
+     lcd.flush();
+}
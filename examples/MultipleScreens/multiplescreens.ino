@@ -0,0 +1,55 @@
+#include <Arduino.h>
+#include <LCD.h>
+#include <LCDGroup.h>
+
+// Two screens sharing the clock (2), output (3) and type (4) lines
+// The first one is enabled on pin 5, reset on pin 6 and has its backlight on pin 7,
+// the second one is enabled on pin 8, reset on pin 9 and has its backlight on pin 10
+LCD left(2, 3, 4, 5, 6, 7);
+LCD right(2, 3, 4, 8, 9, 10);
+
+// The group flushing both screens together
+LCDGroup screens;
+
+void setup()
+{
+     screens.add(left);
+     screens.add(right);
+
+     // Attempt to initialize both LCDs as buffered (default)
+     if (screens.init()) {
+	  // When successful, turn on the backlights, and set to not auto-flush
+	  left.setBacklight();
+	  right.setBacklight();
+	  left.setAutoFlush(false);
+	  right.setAutoFlush(false);
+
+	  // Write a title on each screen, and the same line on both
+	  left.writeString("LEFT", 20, 0, 2);
+	  right.writeString("RIGHT", 12, 0, 2);
+	  left.writeString("SHARED BUS", 12, 24);
+	  right.writeString("SHARED BUS", 12, 24);
+
+	  // The cursor is sent once to both screens, and the line they have in common once too
+	  screens.flush();
+     }
+}
+
+int count = 0;
+
+void loop()
+{
+     char text[12];
+
+     // Count up on the left screen and down on the right one
+     sprintf(text, "%5d", count);
+     left.writeString(text, 12, 32, 2);
+
+     sprintf(text, "%5d", -count);
+     right.writeString(text, 12, 32, 2);
+
+     count++;
+
+     // Only the digits that changed are sent, in a single pass over both screens
+     screens.flush();
+}
@@ -0,0 +1,35 @@
+#include <Arduino.h>
+#include <LCD.h>
+
+// The LCD instance
+LCD lcd;
+
+// The orientations shown in turn
+LCD::orientation orientations[] = { LCD::PORTRAIT, LCD::REV_LANDSCAPE, LCD::REV_PORTRAIT, LCD::LANDSCAPE };
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+     }
+}
+
+void loop()
+{
+     for (int i = 0; i < 4; i++) {
+	  // Draw everything that follows in this orientation
+	  lcd.clear();
+	  lcd.setOrientation(orientations[i]);
+
+	  // Text wraps at the width of the screen in the current orientation
+	  lcd.writeString("UP", 0, 0, 2);
+	  lcd.writeString("this text wraps around", 0, 24);
+
+	  lcd.flush();
+
+	  delay(2000);
+     }
+}
@@ -0,0 +1,112 @@
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <Font.h>
+#include <LCD.h>
+
+// Proportional version of the default font, from character 32 (' ') to character 126 ('~')
+// Every character keeps only its own columns plus one blank column of spacing
+PROGMEM const char narrow[] = { 0x00, 0x00, 0x00, 0x6f, 0x00, 0x07, 0x00, 0x07, 0x00, 0x14, 0x7f,
+				0x14, 0x7f, 0x14, 0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x23,
+				0x13, 0x08, 0x64, 0x62, 0x00, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00,
+				0x07, 0x00, 0x1c, 0x22, 0x41, 0x00, 0x41, 0x22, 0x1c, 0x00, 0x14,
+				0x08, 0x3e, 0x08, 0x14, 0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00,
+				0x50, 0x30, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x60, 0x60,
+				0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x3e, 0x51, 0x49, 0x45,
+				0x3e, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x42, 0x61, 0x51, 0x49, 0x46,
+				0x00, 0x21, 0x41, 0x45, 0x4b, 0x31, 0x00, 0x18, 0x14, 0x12, 0x7f,
+				0x10, 0x00, 0x27, 0x45, 0x45, 0x45, 0x39, 0x00, 0x3c, 0x4a, 0x49,
+				0x49, 0x30, 0x00, 0x01, 0x71, 0x09, 0x05, 0x03, 0x00, 0x36, 0x49,
+				0x49, 0x49, 0x36, 0x00, 0x06, 0x49, 0x49, 0x29, 0x1e, 0x00, 0x36,
+				0x36, 0x00, 0x56, 0x36, 0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x14,
+				0x14, 0x14, 0x14, 0x14, 0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x02,
+				0x01, 0x51, 0x09, 0x06, 0x00, 0x3e, 0x41, 0x5d, 0x49, 0x4e, 0x00,
+				0x7e, 0x09, 0x09, 0x09, 0x7e, 0x00, 0x7f, 0x49, 0x49, 0x49, 0x36,
+				0x00, 0x3e, 0x41, 0x41, 0x41, 0x22, 0x00, 0x7f, 0x41, 0x41, 0x41,
+				0x3e, 0x00, 0x7f, 0x49, 0x49, 0x49, 0x41, 0x00, 0x7f, 0x09, 0x09,
+				0x09, 0x01, 0x00, 0x3e, 0x41, 0x49, 0x49, 0x7a, 0x00, 0x7f, 0x08,
+				0x08, 0x08, 0x7f, 0x00, 0x41, 0x7f, 0x41, 0x00, 0x20, 0x40, 0x41,
+				0x3f, 0x01, 0x00, 0x7f, 0x08, 0x14, 0x22, 0x41, 0x00, 0x7f, 0x40,
+				0x40, 0x40, 0x40, 0x00, 0x7f, 0x02, 0x0c, 0x02, 0x7f, 0x00, 0x7f,
+				0x04, 0x08, 0x10, 0x7f, 0x00, 0x3e, 0x41, 0x41, 0x41, 0x3e, 0x00,
+				0x7f, 0x09, 0x09, 0x09, 0x06, 0x00, 0x3e, 0x41, 0x51, 0x21, 0x5e,
+				0x00, 0x7f, 0x09, 0x19, 0x29, 0x46, 0x00, 0x46, 0x49, 0x49, 0x49,
+				0x31, 0x00, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x00, 0x3f, 0x40, 0x40,
+				0x40, 0x3f, 0x00, 0x0f, 0x30, 0x40, 0x30, 0x0f, 0x00, 0x3f, 0x40,
+				0x30, 0x40, 0x3f, 0x00, 0x63, 0x14, 0x08, 0x14, 0x63, 0x00, 0x07,
+				0x08, 0x70, 0x08, 0x07, 0x00, 0x61, 0x51, 0x49, 0x45, 0x43, 0x00,
+				0x7f, 0x41, 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x7f,
+				0x00, 0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x40, 0x40, 0x40, 0x40,
+				0x40, 0x00, 0x03, 0x04, 0x00, 0x20, 0x54, 0x54, 0x54, 0x78, 0x00,
+				0x7f, 0x48, 0x44, 0x44, 0x38, 0x00, 0x38, 0x44, 0x44, 0x44, 0x20,
+				0x00, 0x38, 0x44, 0x44, 0x48, 0x7f, 0x00, 0x38, 0x54, 0x54, 0x54,
+				0x18, 0x00, 0x08, 0x7e, 0x09, 0x01, 0x02, 0x00, 0x0c, 0x52, 0x52,
+				0x52, 0x3e, 0x00, 0x7f, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7d,
+				0x40, 0x00, 0x20, 0x40, 0x44, 0x3d, 0x00, 0x7f, 0x10, 0x28, 0x44,
+				0x00, 0x41, 0x7f, 0x40, 0x00, 0x7c, 0x04, 0x18, 0x04, 0x78, 0x00,
+				0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38,
+				0x00, 0x7c, 0x14, 0x14, 0x14, 0x08, 0x00, 0x08, 0x14, 0x14, 0x18,
+				0x7c, 0x00, 0x7c, 0x08, 0x04, 0x04, 0x08, 0x00, 0x48, 0x54, 0x54,
+				0x54, 0x20, 0x00, 0x04, 0x3f, 0x44, 0x40, 0x20, 0x00, 0x3c, 0x40,
+				0x40, 0x20, 0x7c, 0x00, 0x1c, 0x20, 0x40, 0x20, 0x1c, 0x00, 0x3c,
+				0x40, 0x30, 0x40, 0x3c, 0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00,
+				0x0c, 0x50, 0x50, 0x50, 0x3c, 0x00, 0x44, 0x64, 0x54, 0x4c, 0x44,
+				0x00, 0x08, 0x36, 0x41, 0x41, 0x00, 0x7f, 0x00, 0x41, 0x41, 0x36,
+				0x08, 0x00, 0x04, 0x02, 0x04, 0x08, 0x04, 0x00 };
+
+// The offset of the first column, and the width, of every character
+PROGMEM const Font::Glyph glyphs[] = { { 0, 3 }, { 3, 2 }, { 5, 4 }, { 9, 6 }, { 15, 6 }, { 21, 6 },
+				       { 27, 6 }, { 33, 2 }, { 35, 4 }, { 39, 4 }, { 43, 6 }, { 49, 6 },
+				       { 55, 3 }, { 58, 6 }, { 64, 3 }, { 67, 6 }, { 73, 6 }, { 79, 4 },
+				       { 83, 6 }, { 89, 6 }, { 95, 6 }, { 101, 6 }, { 107, 6 }, { 113, 6 },
+				       { 119, 6 }, { 125, 6 }, { 131, 3 }, { 134, 3 }, { 137, 5 }, { 142, 6 },
+				       { 148, 5 }, { 153, 6 }, { 159, 6 }, { 165, 6 }, { 171, 6 }, { 177, 6 },
+				       { 183, 6 }, { 189, 6 }, { 195, 6 }, { 201, 6 }, { 207, 6 }, { 213, 4 },
+				       { 217, 6 }, { 223, 6 }, { 229, 6 }, { 235, 6 }, { 241, 6 }, { 247, 6 },
+				       { 253, 6 }, { 259, 6 }, { 265, 6 }, { 271, 6 }, { 277, 6 }, { 283, 6 },
+				       { 289, 6 }, { 295, 6 }, { 301, 6 }, { 307, 6 }, { 313, 6 }, { 319, 3 },
+				       { 322, 6 }, { 328, 3 }, { 331, 6 }, { 337, 6 }, { 343, 3 }, { 346, 6 },
+				       { 352, 6 }, { 358, 6 }, { 364, 6 }, { 370, 6 }, { 376, 6 }, { 382, 6 },
+				       { 388, 6 }, { 394, 4 }, { 398, 5 }, { 403, 5 }, { 408, 4 }, { 412, 6 },
+				       { 418, 6 }, { 424, 6 }, { 430, 6 }, { 436, 6 }, { 442, 6 }, { 448, 6 },
+				       { 454, 6 }, { 460, 6 }, { 466, 6 }, { 472, 6 }, { 478, 6 }, { 484, 6 },
+				       { 490, 6 }, { 496, 5 }, { 501, 2 }, { 503, 5 }, { 508, 6 } };
+
+// Kerning pairs, sorted by left then right character, dropping the spacing column
+PROGMEM const Font::KerningPair kerning[] = { { 'T', 'a', -1 }, { 'T', 'e', -1 }, { 'T', 'o', -1 },
+					      { 'V', 'A', -1 } };
+
+// Declaring the font, 95 characters starting at character 32
+Font font(narrow, glyphs, 95, 32);
+
+// The LCD instance
+LCD lcd;
+
+void setup()
+{
+     font.setKerning(kerning, 4);
+
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+     }
+}
+
+void loop()
+{
+     // The default font fits 13 characters on a line
+     lcd.setFont(Font());
+     lcd.writeString("Fixed width:", 0, 0);
+     lcd.writeString("illustrated 1", 0, 8);
+
+     // The proportional font fits many more
+     lcd.setFont(font);
+     lcd.writeString("Proportional:", 0, 24);
+     lcd.writeString("illustrated 1.1 Today", 0, 32);
+
+     lcd.flush();
+     lcd.clear();
+
+     delay(5000);
+}
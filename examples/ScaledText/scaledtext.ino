@@ -0,0 +1,46 @@
+#include <Arduino.h>
+#include <LCD.h>
+
+// The LCD instance
+LCD lcd;
+
+// The words shown one after the other, each as large as fits on the screen
+const char *words[] = { "HI", "LCD", "5110", "SCALE", "SMOOTH", "any size" };
+
+// The word being shown
+int current = 0;
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+
+	  // Sizes scale the text by themselves instead of by powers of 2,
+	  // with the edges of the characters smoothed at even sizes
+	  lcd.setScaleStyle(LCD::SCALE_SMOOTH);
+     }
+}
+
+void loop()
+{
+     const char *word = words[current];
+     int length = strlen(word);
+     int size = 6;
+
+     // Find the largest size the word fits in, characters are 6x8 pixels at size 1
+     while (size > 1 && (length * 6 * size > lcd.getWidth() || 8 * size > lcd.getHeight())) {
+	  size--;
+     }
+
+     // Center the word on the screen
+     lcd.clear();
+     lcd.writeString(word, (lcd.getWidth() - (length * 6 * size)) / 2, (lcd.getHeight() - (8 * size)) / 2, size);
+     lcd.flush();
+
+     current = (current + 1) % (sizeof(words) / sizeof(words[0]));
+
+     delay(1500);
+}
@@ -0,0 +1,47 @@
+#include <Arduino.h>
+#include <LCD.h>
+
+// The LCD instance
+LCD lcd;
+
+// The angle of the gauge needle, in steps of 1/32 turn
+int angle = 0;
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+     }
+}
+
+void loop()
+{
+     int level = (millis() / 50) % 40;
+
+     lcd.clear();
+
+     // A bar graph in a rounded frame
+     lcd.drawRoundRect(0, 0, 44, 12, 3);
+     lcd.fillRect(2, 2, level, 8);
+
+     // A round gauge with its needle
+     lcd.drawCircle(64, 24, 18);
+     lcd.drawLine(64, 24, 64 + (int) (16 * cos(angle * PI / 16)), 24 + (int) (16 * sin(angle * PI / 16)));
+
+     // Grid lines
+     for (int y = 16; y < 48; y += 8) {
+	  lcd.drawHLine(0, y, 40);
+     }
+
+     lcd.drawVLine(40, 16, 32);
+     lcd.drawRect(0, 16, 40, 32);
+
+     lcd.flush();
+
+     angle = (angle + 1) % 32;
+
+     delay(50);
+}
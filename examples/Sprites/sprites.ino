@@ -0,0 +1,85 @@
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <LCD.h>
+
+// The LCD instance
+LCD lcd;
+
+// Two background tiles: blank, and a dotted pattern
+PROGMEM const char tiles[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			       0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00 };
+
+// Every other tile is dotted
+unsigned char map[11 * 6];
+TileMap background(tiles, map);
+
+// A ball and its mask, 8 pixels wide and 7 high
+char ball[] = { 0x1c, 0x22, 0x41, 0x45, 0x41, 0x22, 0x1c, 0x00 };
+char ballMask[] = { 0x1c, 0x3e, 0x7f, 0x7f, 0x7f, 0x3e, 0x1c, 0x00 };
+Sprite sprite(ball, 8, 7, ballMask);
+
+// A dozen balls bouncing over the background
+SpriteLayer layer(&background, 12);
+int x[12];
+int y[12];
+int dx[12];
+int dy[12];
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+     }
+
+     for (int i = 0; i < 11 * 6; i++) {
+	  map[i] = i & 1;
+     }
+
+     // Shift the ball once for all, so drawing it at any height is as fast
+     sprite.preshift();
+
+     for (int i = 0; i < 12; i++) {
+	  x[i] = random(76);
+	  y[i] = random(41);
+	  dx[i] = random(2) ? 1 : -1;
+	  dy[i] = random(2) ? 1 : -1;
+
+	  layer.setSprite(i, &sprite);
+	  layer.show(i);
+     }
+}
+
+void loop()
+{
+     unsigned long start = millis();
+
+     // Move the balls, bouncing on the edges of the screen
+     for (int i = 0; i < 12; i++) {
+	  if (x[i] + dx[i] < 0 || x[i] + dx[i] > 76) {
+	       dx[i] = -dx[i];
+	  }
+
+	  if (y[i] + dy[i] < 0 || y[i] + dy[i] > 41) {
+	       dy[i] = -dy[i];
+	  }
+
+	  x[i] += dx[i];
+	  y[i] += dy[i];
+
+	  layer.move(i, x[i], y[i]);
+     }
+
+     // Only the tiles the balls moved over are redrawn and flushed
+     layer.draw(lcd);
+     lcd.flush();
+
+     // About 30 frames per second
+     unsigned long elapsed = millis() - start;
+
+     if (elapsed < 33) {
+	  delay(33 - elapsed);
+     }
+}
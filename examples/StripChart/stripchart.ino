@@ -0,0 +1,40 @@
+#include <Arduino.h>
+#include <LCD.h>
+
+// The LCD instance
+LCD lcd;
+
+// The last sample drawn, in pixels from the top of the chart
+int last = 20;
+
+void setup()
+{
+     // Attempt to initialize the LCD as buffered (default)
+     if (lcd.init()) {
+	  // When successful, turn on the backlight, and set to not auto-flush
+	  lcd.setBacklight();
+	  lcd.setAutoFlush(false);
+
+	  // The title stays, only the chart below it scrolls
+	  lcd.writeString("ANALOG 0", 0, 0);
+	  lcd.flush();
+     }
+}
+
+void loop()
+{
+     // Read a sample, scaled to the 40 pixels of the chart
+     int sample = 39 - (analogRead(0) * 40L / 1024);
+
+     // Move the chart a column to the left, then join the last sample to the new one
+     // in the free column on the right
+     lcd.scroll(-1, 0, 0, 8, 84, 40);
+     lcd.drawLine(82, 8 + last, 83, 8 + sample);
+
+     last = sample;
+
+     // Only the chart is sent
+     lcd.flush();
+
+     delay(50);
+}
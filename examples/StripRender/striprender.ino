@@ -0,0 +1,41 @@
+#include <Arduino.h>
+#include <LCD.h>
+
+// The LCD instance
+LCD lcd;
+
+// The strip the screen is rendered in, a single screen row of 84 bytes
+char strip[84];
+
+// The value shown by the bar graph
+int level = 0;
+
+// Draw the whole screen, called once for every strip
+void draw()
+{
+     // Text at any height and size, which unbuffered output cannot do
+     lcd.writeString("LEVEL", 2, 3, 2);
+
+     lcd.drawRect(2, 22, 80, 12);
+     lcd.fillRect(4, 24, level, 8);
+
+     lcd.drawCircle(42, 42, 4);
+}
+
+void setup()
+{
+     // Initialize the LCD as not buffered, leaving the RAM of the screen buffer to the sketch
+     if (lcd.init(false)) {
+	  lcd.setBacklight();
+     }
+}
+
+void loop()
+{
+     // Render the screen a screen row at a time through the strip
+     lcd.render(draw, 1, strip);
+
+     level = (level + 1) % 77;
+
+     delay(50);
+}
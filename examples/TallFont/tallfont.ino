@@ -0,0 +1,69 @@
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <Font.h>
+#include <LCD.h>
+
+// Seven segment digits of 12x16 pixels, from character 45 ('-') to character 58 (':')
+// Each column is two bytes, the top one first
+PROGMEM char digits[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01,  // '-'
+			  0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0,  // '.'
+			  0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0xc0, 0x00, 0x60, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x03,  // '/'
+			  0xc0, 0x00, 0x60, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x03, 0x00, 0x00, 0x00,
+			  0x00, 0x00, 0x7c, 0x3e, 0x7c, 0x3e, 0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0,  // '0'
+			  0x03, 0xc0, 0x03, 0xc0, 0x03, 0xc0, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // '1'
+			  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0x3e, 0x00, 0x3e, 0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1,  // '2'
+			  0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1, 0x7c, 0x00, 0x7c, 0x00, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1,  // '3'
+			  0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01,  // '4'
+			  0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1,  // '5'
+			  0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1, 0x00, 0x3e, 0x00, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x7c, 0x3e, 0x7c, 0x3e, 0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1,  // '6'
+			  0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1, 0x00, 0x3e, 0x00, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00,  // '7'
+			  0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x7c, 0x3e, 0x7c, 0x3e, 0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1,  // '8'
+			  0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x7c, 0x00, 0x7c, 0x00, 0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1,  // '9'
+			  0x83, 0xc1, 0x83, 0xc1, 0x83, 0xc1, 0x7c, 0x3e, 0x7c, 0x3e, 0x00, 0x00,
+			  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x0c,  // ':'
+			  0x30, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+// Declaring the font, 14 characters, 12 pixels wide, starting at character 45, 16 pixels high
+Font font(digits, 14, 12, '-', 16);
+
+// The LCD instance
+LCD lcd;
+
+void setup()
+{
+     // Attempt to initialize the LCD without a screen buffer, the digits are sent
+     // straight to the screen, two screen rows at a time
+     if (lcd.init(false)) {
+	  // When successful, turn on the backlight
+	  lcd.setBacklight();
+	  lcd.clear();
+
+	  lcd.writeString("UPTIME", 0, 0);
+
+	  // Set the tall digits as the LCD font
+	  lcd.setFont(font);
+     }
+}
+
+void loop()
+{
+     char text[8];
+     unsigned long seconds = millis() / 1000;
+
+     // Write the minutes and seconds, on the screen rows 2 and 3
+     sprintf(text, "%02lu:%02lu", (seconds / 60) % 100, seconds % 60);
+     lcd.writeString(text, 12, 16);
+
+     delay(200);
+}
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Convert a PBM image into a run-length encoded bitmap for LCD::drawBitmapRLE.
+
+The output is a C array to paste into a sketch. The format is described in
+LCD.h: a width byte and a height byte, then the screen rows of 8 pixels,
+each stored column by column, packed in runs:
+
+  control byte 0x00-0x7F: the next (control + 1) bytes are copied as is
+  control byte 0x80-0xFF: the next byte is repeated (control - 0x80 + 1) times
+
+Usage: bitmap2rle.py image.pbm [name] > image.h
+"""
+
+import sys
+
+
+def read_pbm(path):
+    """Return (width, height, pixels) of a P1 or P4 PBM, pixels[y][x] true when black."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    # Split the header into tokens, skipping comments
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            while data[pos:pos + 1] not in (b'\n', b''):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    pos += 1
+
+    if magic == b'P4':
+        stride = (width + 7) // 8
+        pixels = [[bool(data[pos + y * stride + x // 8] & (0x80 >> (x % 8)))
+                   for x in range(width)] for y in range(height)]
+    elif magic == b'P1':
+        bits = [c == ord('1') for c in data[pos:] if c in b'01']
+        pixels = [bits[y * width:(y + 1) * width] for y in range(height)]
+    else:
+        raise ValueError('not a PBM image')
+
+    return width, height, pixels
+
+
+def to_columns(width, height, pixels):
+    """Return the bytes of the image, a screen row of 8 pixels at a time."""
+    columns = []
+    for row in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = row * 8 + bit
+                if y < height and pixels[y][x]:
+                    byte |= 1 << bit
+            columns.append(byte)
+    return columns
+
+
+def encode(width, height, columns):
+    """Return the run-length encoded bitmap, header included."""
+    out = [width, height]
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:128]
+            del literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(columns):
+        run = 1
+        while i + run < len(columns) and run < 128 and columns[i + run] == columns[i]:
+            run += 1
+        # Runs shorter than 3 bytes are cheaper as literals
+        if run >= 3:
+            flush_literal()
+            out.extend([0x80 + run - 1, columns[i]])
+        else:
+            literal.extend(columns[i:i + run])
+        i += run
+    flush_literal()
+
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+
+    name = sys.argv[2] if len(sys.argv) > 2 else 'bitmap'
+    width, height, pixels = read_pbm(sys.argv[1])
+
+    if width > 255 or height > 255:
+        sys.exit('images are limited to 255 x 255 pixels')
+
+    data = encode(width, height, to_columns(width, height, pixels))
+
+    print('// %d x %d, %d bytes' % (width, height, len(data)))
+    print('PROGMEM const char %s[] = {' % name)
+    for i in range(0, len(data), 12):
+        print('     ' + ', '.join('0x%02x' % b for b in data[i:i + 12]) + ',')
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
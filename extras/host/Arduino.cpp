@@ -0,0 +1,101 @@
+#include <time.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include "PCD8544.h"
+
+SPIClass SPI;
+
+// Time spent in delay, added to the real time
+static unsigned long s_delayed = 0;
+
+// Returns the real time in microseconds since the first call
+static unsigned long now()
+{
+     static struct timespec start;
+     static bool started = false;
+     struct timespec t;
+
+     clock_gettime(CLOCK_MONOTONIC, &t);
+
+     if (!started) {
+	  start = t;
+	  started = true;
+     }
+
+     return ((t.tv_sec - start.tv_sec) * 1000000UL) + ((t.tv_nsec - start.tv_nsec) / 1000);
+}
+
+void pinMode(int pin, int mode)
+{
+     // Every pin is an output
+}
+
+void digitalWrite(int pin, int value)
+{
+     SimulatedLCD.pinChanged(pin, value);
+}
+
+int analogRead(int pin)
+{
+     static int reads = 0;
+
+     return 512 + (int) (511 * sin(reads++ * 0.1));
+}
+
+void delay(unsigned long ms)
+{
+     s_delayed += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+     s_delayed += us;
+}
+
+unsigned long millis()
+{
+     return micros() / 1000;
+}
+
+unsigned long micros()
+{
+     return now() + s_delayed;
+}
+
+long random(long max)
+{
+     return max > 0 ? rand() % max : 0;
+}
+
+long random(long min, long max)
+{
+     return min < max ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed)
+{
+     srand(seed);
+}
+
+void SPIClass::begin()
+{
+}
+
+void SPIClass::end()
+{
+}
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+}
+
+void SPIClass::endTransaction()
+{
+}
+
+uint8_t SPIClass::transfer(uint8_t byte)
+{
+     SimulatedLCD.spiTransfer(byte);
+
+     return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+
+// Stand-in for the Arduino core, to build the library and sketches on a computer
+// The pins drive the PCD8544 model of PCD8544.h instead of a board
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+
+#define LOW 0
+#define HIGH 1
+
+#define INPUT 0
+#define OUTPUT 1
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Set the mode of a pin, every pin is an output
+void pinMode(int pin, int mode);
+
+// Set a pin high or low, the pins wired to the model are passed on to it
+void digitalWrite(int pin, int value);
+
+// Read an analog pin, every pin reads a slow wave from 0 to 1023, a step further on every read
+int analogRead(int pin);
+
+// Wait for the given time, which only moves the simulated clock forward
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Returns the time since the program started, plus the time spent in delay
+unsigned long millis();
+unsigned long micros();
+
+// Returns a pseudo random number from min to max - 1, or 0 to max - 1
+long random(long max);
+long random(long min, long max);
+
+// Seed the pseudo random numbers
+void randomSeed(unsigned long seed);
+
+#endif /* ARDUINO_H_ */
@@ -0,0 +1,306 @@
+#include <string.h>
+#include "PCD8544.h"
+
+PCD8544 SimulatedLCD;
+
+PCD8544::PCD8544()
+{
+     // Wire the controller like the LCD4884 shield, all pins low
+     memset(m_levels, 0, sizeof(m_levels));
+     setPins();
+
+     reset();
+     resetCounters();
+}
+
+void PCD8544::setPins(int clock, int output, int type, int enable, int reset)
+{
+     m_clock = clock;
+     m_output = output;
+     m_type = type;
+     m_enable = enable;
+     m_reset = reset;
+}
+
+void PCD8544::pinChanged(int pin, int value)
+{
+     // Only the levels of the first 64 pins are kept
+     if (pin < 0 || pin >= 64) {
+	  return;
+     }
+
+     bool previous = m_levels[pin];
+
+     m_levels[pin] = value != 0;
+
+     // Ignore the pins the controller is not wired to
+     if (pin != m_clock && pin != m_output && pin != m_type && pin != m_enable && pin != m_reset) {
+	  return;
+     }
+
+     // Count the edges, writing the level a pin already has changes nothing
+     if ((value != 0) != previous) {
+	  m_changes++;
+     }
+
+     // The controller resets while the reset pin is low
+     if (pin == m_reset && !value) {
+	  reset();
+     }
+
+     // Disabling the chip drops the bits of an incomplete byte
+     if (pin == m_enable && value) {
+	  m_bits = 0;
+     }
+
+     // Read a bit on the rising edges of the clock, while the chip is enabled
+     if (pin == m_clock && value && !previous && !m_levels[m_enable] && m_levels[m_reset]) {
+	  m_shift = (m_shift << 1) | (m_levels[m_output] ? 1 : 0);
+
+	  if (++m_bits == 8) {
+	       receive(m_shift, m_levels[m_type]);
+	       m_bits = 0;
+	  }
+     }
+}
+
+void PCD8544::spiTransfer(unsigned char byte)
+{
+     // The whole byte is shifted in at once, while the chip is enabled
+     if (!m_levels[m_enable] && m_levels[m_reset]) {
+	  receive(byte, m_levels[m_type]);
+     }
+}
+
+bool PCD8544::getPixel(int x, int y)
+{
+     if (x < 0 || x >= 84 || y < 0 || y >= 48 || m_powerDown) {
+	  return false;
+     }
+
+     bool bit = (m_ram[((y / 8) * 84) + x] >> (y % 8)) & 1;
+
+     switch (m_displayMode) {
+     case 1:
+	  return true;
+     case 2:
+	  return bit;
+     case 3:
+	  return !bit;
+     default:
+	  return false;
+     }
+}
+
+const unsigned char *PCD8544::getRAM()
+{
+     return m_ram;
+}
+
+bool PCD8544::writePBM(const char *path, int scale)
+{
+     FILE *file = fopen(path, "wb");
+
+     if (!file) {
+	  return false;
+     }
+
+     bool written = writePBM(file, scale);
+
+     return fclose(file) == 0 && written;
+}
+
+bool PCD8544::writePBM(FILE *file, int scale)
+{
+     // Binary PBM, rows of pixels packed 8 to a byte, high bit first, 1 for black
+     fprintf(file, "P4\n%d %d\n", 84 * scale, 48 * scale);
+
+     for (int y = 0; y < 48 * scale; y++) {
+	  unsigned char byte = 0;
+	  int bits = 0;
+
+	  for (int x = 0; x < 84 * scale; x++) {
+	       byte = (byte << 1) | (getPixel(x / scale, y / scale) ? 1 : 0);
+
+	       if (++bits == 8) {
+		    fputc(byte, file);
+		    byte = 0;
+		    bits = 0;
+	       }
+	  }
+
+	  // Pad the end of the row
+	  if (bits > 0) {
+	       fputc(byte << (8 - bits), file);
+	  }
+     }
+
+     return !ferror(file);
+}
+
+void PCD8544::print(FILE *file)
+{
+     for (int y = 0; y < 48; y++) {
+	  for (int x = 0; x < 84; x++) {
+	       fputc(getPixel(x, y) ? '#' : '.', file);
+	  }
+
+	  fputc('\n', file);
+     }
+}
+
+int PCD8544::getX()
+{
+     return m_x;
+}
+
+int PCD8544::getY()
+{
+     return m_y;
+}
+
+bool PCD8544::isPowerDown()
+{
+     return m_powerDown;
+}
+
+bool PCD8544::isVertical()
+{
+     return m_vertical;
+}
+
+bool PCD8544::isExtended()
+{
+     return m_extended;
+}
+
+int PCD8544::getDisplayMode()
+{
+     return m_displayMode;
+}
+
+int PCD8544::getOperatingVoltage()
+{
+     return m_vop;
+}
+
+int PCD8544::getBiasSystem()
+{
+     return m_bias;
+}
+
+int PCD8544::getTemperatureControl()
+{
+     return m_tc;
+}
+
+long PCD8544::getDataCount()
+{
+     return m_data;
+}
+
+long PCD8544::getCommandCount()
+{
+     return m_commands;
+}
+
+long PCD8544::getPinChanges()
+{
+     return m_changes;
+}
+
+void PCD8544::resetCounters()
+{
+     m_data = 0;
+     m_commands = 0;
+     m_changes = 0;
+}
+
+// Private functions below
+
+void PCD8544::reset()
+{
+     // The state after a reset, from the datasheet, the RAM is cleared to be predictable
+     memset(m_ram, 0, sizeof(m_ram));
+     m_x = 0;
+     m_y = 0;
+     m_powerDown = true;
+     m_vertical = false;
+     m_extended = false;
+     m_displayMode = 0;
+     m_vop = 0;
+     m_bias = 0;
+     m_tc = 0;
+     m_shift = 0;
+     m_bits = 0;
+}
+
+void PCD8544::receive(unsigned char byte, bool data)
+{
+     if (!data) {
+	  m_commands++;
+	  command(byte);
+	  return;
+     }
+
+     m_data++;
+
+     // Write the byte, and move the address counter
+     m_ram[(m_y * 84) + m_x] = byte;
+
+     if (m_vertical) {
+	  if (++m_y > 5) {
+	       m_y = 0;
+
+	       if (++m_x > 83) {
+		    m_x = 0;
+	       }
+	  }
+     }
+     else {
+	  if (++m_x > 83) {
+	       m_x = 0;
+
+	       if (++m_y > 5) {
+		    m_y = 0;
+	       }
+	  }
+     }
+}
+
+void PCD8544::command(unsigned char byte)
+{
+     // Function set, in both instruction sets
+     if ((byte & 0xF8) == 0x20) {
+	  m_powerDown = byte & 0x04;
+	  m_vertical = byte & 0x02;
+	  m_extended = byte & 0x01;
+	  return;
+     }
+
+     if (m_extended) {
+	  if (byte & 0x80) {
+	       m_vop = byte & 0x7F;
+	  }
+	  else if ((byte & 0xF8) == 0x10) {
+	       m_bias = byte & 0x07;
+	  }
+	  else if ((byte & 0xFC) == 0x04) {
+	       m_tc = byte & 0x03;
+	  }
+
+	  return;
+     }
+
+     // Addresses out of range are undefined, they wrap here
+     if (byte & 0x80) {
+	  m_x = (byte & 0x7F) % 84;
+     }
+     else if ((byte & 0xF8) == 0x40) {
+	  m_y = (byte & 0x07) % 6;
+     }
+     else if ((byte & 0xFA) == 0x08) {
+	  // Display control, D and E bits
+	  m_displayMode = ((byte & 0x04) ? 2 : 0) | (byte & 0x01);
+     }
+}
@@ -0,0 +1,109 @@
+#ifndef PCD8544_H_
+#define PCD8544_H_
+
+#include <stdio.h>
+
+// Software model of the PCD8544 controller of the LCD screen, for builds on a computer
+// It decodes the serial stream on the pins written with digitalWrite (bit-bang transports),
+// or the bytes sent with SPI.transfer (SPITransport), like the controller does:
+// bits are read on the rising edges of the clock while the chip is enabled, high bit first,
+// and the type pin selects data or command when the 8th bit is read.
+class PCD8544
+{
+public:
+     // Create a controller wired to the pins of the LCD4884 shield
+     PCD8544();
+
+     // Set the pins the controller is wired to
+     void setPins(int clock = 2, int output = 3, int type = 4, int enable = 5, int reset = 6);
+
+     // A pin was set high or low, called by digitalWrite
+     void pinChanged(int pin, int value);
+
+     // A byte was shifted by the SPI peripheral, called by SPI.transfer
+     void spiTransfer(unsigned char byte);
+
+     // Execute a complete byte, as if shifted in with the type pin high for data
+     // Replays the bytes recorded by a CaptureTransport
+     void receive(unsigned char byte, bool data);
+
+     // Returns whether the pixel at (x, y) is dark, as shown by the screen
+     // Takes the display mode and the power down state into account
+     bool getPixel(int x, int y);
+
+     // Returns the display RAM, byte (x, row) at index row * 84 + x
+     const unsigned char *getRAM();
+
+     // Write what the screen shows as a PBM image, scaled up by scale
+     // Returns false if the file could not be written
+     bool writePBM(const char *path, int scale = 1);
+     bool writePBM(FILE *file, int scale = 1);
+
+     // Print what the screen shows with one character per pixel
+     void print(FILE *file = stdout);
+
+     // The state of the controller
+     int getX();
+     int getY();
+     bool isPowerDown();
+     bool isVertical();
+     bool isExtended();
+     int getDisplayMode(); // D and E bits, 0 blank, 1 all on, 2 normal, 3 inverted
+     int getOperatingVoltage();
+     int getBiasSystem();
+     int getTemperatureControl();
+
+     // Returns the number of data bytes, command bytes and pin changes since the last reset
+     // A pin change is an edge of a wired pin, writing the level it already has is not counted
+     long getDataCount();
+     long getCommandCount();
+     long getPinChanges();
+
+     // Reset the counters
+     void resetCounters();
+
+private:
+     // The pins the controller is wired to, and their levels
+     int m_clock;
+     int m_output;
+     int m_type;
+     int m_enable;
+     int m_reset;
+     bool m_levels[64];
+
+     // The byte being shifted in, and its number of bits
+     unsigned char m_shift;
+     int m_bits;
+
+     // The display RAM and the address counter
+     unsigned char m_ram[504];
+     int m_x;
+     int m_y;
+
+     // Function set
+     bool m_powerDown;
+     bool m_vertical;
+     bool m_extended;
+
+     // Other settings
+     int m_displayMode;
+     int m_vop;
+     int m_bias;
+     int m_tc;
+
+     // The counters
+     long m_data;
+     long m_commands;
+     long m_changes;
+
+     // Reset the controller, as when the reset pin goes low
+     void reset();
+
+     // Execute a command byte
+     void command(unsigned char byte);
+};
+
+// The controller driven by digitalWrite and SPI.transfer
+extern PCD8544 SimulatedLCD;
+
+#endif /* PCD8544_H_ */
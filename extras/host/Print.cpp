@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include "Print.h"
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+     size_t count = 0;
+
+     while (size-- > 0) {
+	  count += write(*buffer++);
+     }
+
+     return count;
+}
+
+size_t Print::write(const char *string)
+{
+     if (!string) {
+	  return 0;
+     }
+
+     return write((const uint8_t *) string, strlen(string));
+}
+
+size_t Print::write(const char *buffer, size_t size)
+{
+     return write((const uint8_t *) buffer, size);
+}
+
+size_t Print::print(const char *string)
+{
+     return write(string);
+}
+
+size_t Print::print(char character)
+{
+     return write((uint8_t) character);
+}
+
+size_t Print::print(int number, int base)
+{
+     return print((long) number, base);
+}
+
+size_t Print::print(unsigned int number, int base)
+{
+     return print((unsigned long) number, base);
+}
+
+size_t Print::print(long number, int base)
+{
+     // Like the Arduino core, only base 10 numbers are printed with a sign
+     if (base == DEC && number < 0) {
+	  return printNumber(-(unsigned long) number, base, true);
+     }
+
+     return printNumber(number, base, false);
+}
+
+size_t Print::print(unsigned long number, int base)
+{
+     return printNumber(number, base, false);
+}
+
+size_t Print::print(double number, int digits)
+{
+     char text[32];
+
+     snprintf(text, sizeof(text), "%.*f", digits, number);
+
+     return write(text);
+}
+
+size_t Print::println(const char *string)
+{
+     return print(string) + println();
+}
+
+size_t Print::println(char character)
+{
+     return print(character) + println();
+}
+
+size_t Print::println(int number, int base)
+{
+     return print(number, base) + println();
+}
+
+size_t Print::println(unsigned int number, int base)
+{
+     return print(number, base) + println();
+}
+
+size_t Print::println(long number, int base)
+{
+     return print(number, base) + println();
+}
+
+size_t Print::println(unsigned long number, int base)
+{
+     return print(number, base) + println();
+}
+
+size_t Print::println(double number, int digits)
+{
+     return print(number, digits) + println();
+}
+
+size_t Print::println()
+{
+     return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long number, int base, bool negative)
+{
+     // Build the digits from the last one, in a buffer large enough for base 2
+     char text[8 * sizeof(long) + 2];
+     char *digit = text + sizeof(text) - 1;
+
+     if (base < 2) {
+	  base = DEC;
+     }
+
+     *digit = 0;
+
+     do {
+	  int value = number % base;
+
+	  *--digit = value < 10 ? '0' + value : 'A' + value - 10;
+	  number /= base;
+     } while (number > 0);
+
+     if (negative) {
+	  *--digit = '-';
+     }
+
+     return write(digit);
+}
@@ -0,0 +1,57 @@
+#ifndef PRINT_H_
+#define PRINT_H_
+
+// Stand-in for the Print class of the Arduino core, the base class of Serial
+// A class writing characters implements write(uint8_t), and gets the print and println functions
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print
+{
+public:
+     virtual ~Print()
+     {
+     }
+
+     // Write a single character, returns the number of characters written
+     virtual size_t write(uint8_t character) = 0;
+
+     // Write size characters, one at a time by default
+     virtual size_t write(const uint8_t *buffer, size_t size);
+
+     // Write a string, or size characters of it
+     size_t write(const char *string);
+     size_t write(const char *buffer, size_t size);
+
+     // Print a string, a character, or a number in the given base
+     size_t print(const char *string);
+     size_t print(char character);
+     size_t print(int number, int base = DEC);
+     size_t print(unsigned int number, int base = DEC);
+     size_t print(long number, int base = DEC);
+     size_t print(unsigned long number, int base = DEC);
+     size_t print(double number, int digits = 2);
+
+     // The same, followed by a new line ("\r\n")
+     size_t println(const char *string);
+     size_t println(char character);
+     size_t println(int number, int base = DEC);
+     size_t println(unsigned int number, int base = DEC);
+     size_t println(long number, int base = DEC);
+     size_t println(unsigned long number, int base = DEC);
+     size_t println(double number, int digits = 2);
+     size_t println();
+
+private:
+     // Print a number in the given base, with a minus sign if negative
+     size_t printNumber(unsigned long number, int base, bool negative);
+};
+
+#endif /* PRINT_H_ */
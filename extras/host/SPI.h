@@ -0,0 +1,41 @@
+#ifndef SPI_H_
+#define SPI_H_
+
+// Stand-in for the Arduino SPI library, the bytes go to the PCD8544 model of PCD8544.h
+
+#include <stdint.h>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define SPI_MODE0 0x00
+
+// Settings of a transaction, ignored
+class SPISettings
+{
+public:
+     SPISettings()
+     {
+     }
+
+     SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+     {
+     }
+};
+
+// The SPI peripheral, sending every byte to the model at once
+class SPIClass
+{
+public:
+     void begin();
+     void end();
+     void beginTransaction(SPISettings settings);
+     void endTransaction();
+
+     // Send a byte to the model, returns 0 as nothing is read back
+     uint8_t transfer(uint8_t byte);
+};
+
+extern SPIClass SPI;
+
+#endif /* SPI_H_ */
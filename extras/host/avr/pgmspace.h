@@ -0,0 +1,18 @@
+#ifndef PGMSPACE_H_
+#define PGMSPACE_H_
+
+// Stand-in for the program memory functions of avr-libc
+// On a computer program memory is plain memory, read directly
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(address) (*(const uint8_t *) (address))
+#define pgm_read_word(address) (*(const uint16_t *) (address))
+#define pgm_read_dword(address) (*(const uint32_t *) (address))
+
+#define memcpy_P(destination, source, count) memcpy((destination), (source), (count))
+
+#endif /* PGMSPACE_H_ */
@@ -0,0 +1,337 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <Arduino.h>
+#include <LCD.h>
+#include "PCD8544.h"
+
+// Runs standardized workloads through the library and the PCD8544 model, and reports what
+// a frame of each costs as JSON: bytes and commands sent, GPIO toggles, and host CPU time,
+// both with the bit-bang transport driving the model, and through a CaptureTransport that
+// only counts the bytes, which leaves the time spent in the library itself. Workloads using
+// a GlyphCache also report the share of lookups found in it, null for the others.
+// Usage: bench [frames]
+
+// A bitmap of 24x24 pixels, a ring
+static char ring[72];
+
+// The digits of the default font expanded to 24x32 pixels, 4 bytes per column
+static char tallDigits[10 * 24 * 4];
+static Font tallFont(tallDigits, 10, 24, '0', 32);
+
+// The characters cycled through by the text workloads
+static char text(int frame, int i)
+{
+     return 32 + ((frame + i) % 95);
+}
+
+// Full screen of size 1 text, different every frame
+static void textFrame(LCD &lcd, int frame)
+{
+     char line[15];
+
+     for (int row = 0; row < 6; row++) {
+	  for (int i = 0; i < 14; i++) {
+	       line[i] = text(frame, (row * 14) + i);
+	  }
+
+	  line[14] = 0;
+	  lcd.writeString(line, 0, row * 8);
+     }
+
+     lcd.flush();
+}
+
+// The same text read from a glyph cache with a slot for every printable character
+static void textCachedFrame(LCD &lcd, int frame)
+{
+     static GlyphCache cache(96, 6);
+
+     // Every run starts from an empty cache, and counts its own hits
+     if (frame == 0) {
+	  cache.clear();
+	  cache.resetCounters();
+	  lcd.setGlyphCache(&cache);
+     }
+
+     textFrame(lcd, frame);
+}
+
+// The same text with the default font as a FixedFont
+static void textFixedFrame(LCD &lcd, int frame)
+{
+     char line[15];
+
+     for (int row = 0; row < 6; row++) {
+	  for (int i = 0; i < 14; i++) {
+	       line[i] = text(frame, (row * 14) + i);
+	  }
+
+	  line[14] = 0;
+	  lcd.writeString(DEFAULT_FIXED_FONT, line, 0, row * 8);
+     }
+
+     lcd.flush();
+}
+
+// A counter of size 3 digits, only the changing digits change the screen
+static void digitsFrame(LCD &lcd, int frame)
+{
+     char digits[12];
+
+     sprintf(digits, "%04d", frame % 10000);
+     lcd.writeString(digits, 0, 12, 3);
+     lcd.flush();
+}
+
+// A counter at 4 times the size of the font, with the edges of the digits smoothed
+static void digitsSmoothFrame(LCD &lcd, int frame)
+{
+     char digits[12];
+
+     sprintf(digits, "%03d", frame % 1000);
+     lcd.setScaleStyle(LCD::SCALE_SMOOTH);
+     lcd.writeString(digits, 0, 4, 4);
+     lcd.flush();
+}
+
+// The same counter with a font of 32 pixel high digits, on a screen row boundary
+static void digitsTallFrame(LCD &lcd, int frame)
+{
+     char digits[12];
+
+     sprintf(digits, "%04d", frame % 10000);
+     lcd.setFont(tallFont);
+     lcd.writeString(digits, 0, 8);
+     lcd.flush();
+}
+
+// The whole character map scrolling up a pixel every frame, like the Charmap example
+static void scrollFrame(LCD &lcd, int frame)
+{
+     static char charmap[242];
+
+     for (int i = 0; i < 241; i++) {
+	  charmap[i] = i + 1;
+     }
+
+     lcd.clear();
+     lcd.writeString(charmap, 0, -(frame % 64));
+     lcd.flush();
+}
+
+// A strip chart below a title, moving a column left every frame for a new sample
+static void chartFrame(LCD &lcd, int frame)
+{
+     static int sample;
+
+     // Every run starts from the same sample
+     if (frame == 0) {
+	  sample = 20;
+
+	  lcd.clear();
+	  lcd.writeString("CHART", 0, 0);
+     }
+
+     int previous = sample;
+
+     sample = 20 + (int) (18 * sin(frame * 0.1));
+
+     lcd.scroll(-1, 0, 0, 8, 84, 40);
+     lcd.drawLine(82, 8 + previous, 83, 8 + sample);
+     lcd.flush();
+}
+
+// A bitmap moving across the screen, at any height
+static void bitmapFrame(LCD &lcd, int frame)
+{
+     int x = frame % 60;
+     int y = (frame * 3) % 24;
+
+     lcd.clear();
+     lcd.drawBitmap(ring, x, y, 24, 24);
+     lcd.flush();
+}
+
+// A dozen 8x8 sprites bouncing over a blank background
+static void spritesFrame(LCD &lcd, int frame)
+{
+     static Sprite ball(ring + 8, 8, 8);
+     static SpriteLayer *layer = 0;
+
+     // Every run starts from a new layer, without the positions of the previous run,
+     // and draws the whole layer first
+     if (frame == 0) {
+	  delete layer;
+	  layer = new SpriteLayer(0, 12);
+
+	  for (int i = 0; i < 12; i++) {
+	       layer->setSprite(i, &ball);
+	       layer->show(i);
+	  }
+
+	  layer->invalidate();
+     }
+
+     for (int i = 0; i < 12; i++) {
+	  int x = (frame + (i * 17)) % 152;
+	  int y = (frame + (i * 11)) % 80;
+
+	  // Bounce on the edges of the screen
+	  layer->move(i, x < 76 ? x : 152 - x, y < 40 ? y : 80 - y);
+     }
+
+     layer->draw(lcd);
+     lcd.flush();
+}
+
+// Clearing and flushing the whole screen
+static void clearFrame(LCD &lcd, int frame)
+{
+     lcd.clear();
+     lcd.drawPixel(frame % 84, frame % 48);
+     lcd.flush();
+}
+
+// A flush with nothing changed
+static void idleFrame(LCD &lcd, int frame)
+{
+     lcd.flush();
+}
+
+// Full screen of text written straight to the screen
+static void textDirectFrame(LCD &lcd, int frame)
+{
+     char line[15];
+
+     for (int row = 0; row < 6; row++) {
+	  for (int i = 0; i < 14; i++) {
+	       line[i] = text(frame, (row * 14) + i);
+	  }
+
+	  line[14] = 0;
+	  lcd.writeStringDirect(line, 0, row);
+     }
+}
+
+// A bitmap moving across the screen, drawn straight to the screen on whole screen rows
+static void bitmapDirectFrame(LCD &lcd, int frame)
+{
+     lcd.drawBitmapDirect(ring, frame % 60, (frame / 60) % 3, 24, 24);
+}
+
+// A workload, run on a buffered or an unbuffered LCD
+struct Workload {
+     const char *name;
+     bool buffered;
+     void (*frame)(LCD &lcd, int frame);
+};
+
+static const Workload WORKLOADS[] = {
+     { "text_fullscreen", true, textFrame },
+     { "text_glyph_cache", true, textCachedFrame },
+     { "text_fixed_font", true, textFixedFrame },
+     { "digits_size3", true, digitsFrame },
+     { "digits_tall_font", true, digitsTallFrame },
+     { "digits_smooth_size4", true, digitsSmoothFrame },
+     { "scroll_charmap", true, scrollFrame },
+     { "strip_chart", true, chartFrame },
+     { "bitmap_animation", true, bitmapFrame },
+     { "sprites_12", true, spritesFrame },
+     { "clear_flush", true, clearFrame },
+     { "flush_unchanged", true, idleFrame },
+     { "text_direct", false, textDirectFrame },
+     { "bitmap_direct", false, bitmapDirectFrame }
+};
+
+// Returns the CPU time used by the process, in microseconds
+static double cpuTime()
+{
+     struct timespec t;
+
+     clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+
+     return (t.tv_sec * 1e6) + (t.tv_nsec / 1e3);
+}
+
+int main(int argc, char **argv)
+{
+     int frames = argc > 1 ? atoi(argv[1]) : 200;
+     int count = sizeof(WORKLOADS) / sizeof(WORKLOADS[0]);
+
+     // Draw the ring
+     for (int x = 0; x < 24; x++) {
+	  for (int y = 0; y < 24; y++) {
+	       int dx = (2 * x) - 23;
+	       int dy = (2 * y) - 23;
+	       int d = (dx * dx) + (dy * dy);
+
+	       if (d < 23 * 23 && d > 14 * 14) {
+		    ring[((y / 8) * 24) + x] |= 1 << (y % 8);
+	       }
+	  }
+     }
+
+     // Expand the digits, every pixel of the default font becoming 4x4 pixels
+     for (int i = 0; i < 24 * 4 * 10; i++) {
+	  unsigned char column = DEFAULT_FONT['0' - 1 + (i / 96)][(i % 96) / 16];
+	  int row = i % 4;
+
+	  tallDigits[i] = ((column >> (2 * row)) & 1 ? 0x0F : 0) | ((column >> ((2 * row) + 1)) & 1 ? 0xF0 : 0);
+     }
+
+     printf("{\n  \"frames\": %d,\n  \"benchmarks\": [\n", frames);
+
+     for (int i = 0; i < count; i++) {
+	  const Workload &workload = WORKLOADS[i];
+	  LCD lcd;
+
+	  lcd.init(workload.buffered);
+	  lcd.setAutoFlush(false);
+
+	  // Count from a known state, the first frame included
+	  SimulatedLCD.resetCounters();
+
+	  double start = cpuTime();
+
+	  for (int frame = 0; frame < frames; frame++) {
+	       workload.frame(lcd, frame);
+	  }
+
+	  double elapsed = cpuTime() - start;
+
+	  // The same frames, sent nowhere
+	  CaptureTransport capture(0, 0);
+	  LCD library(capture);
+
+	  library.init(workload.buffered);
+	  library.setAutoFlush(false);
+
+	  start = cpuTime();
+
+	  for (int frame = 0; frame < frames; frame++) {
+	       workload.frame(library, frame);
+	  }
+
+	  double libraryElapsed = cpuTime() - start;
+
+	  // The share of the glyph lookups found in the cache, if the workload uses one
+	  GlyphCache *cache = library.getGlyphCache();
+	  char hitRate[16] = "null";
+
+	  if (cache && cache->getHits() + cache->getMisses() > 0) {
+	       sprintf(hitRate, "%.3f", (double) cache->getHits() / (cache->getHits() + cache->getMisses()));
+	  }
+
+	  printf("    {\"name\": \"%s\", \"buffered\": %s, \"data_bytes_per_frame\": %.1f, "
+		 "\"command_bytes_per_frame\": %.1f, \"gpio_toggles_per_frame\": %.1f, \"cpu_us_per_frame\": %.2f, \"library_cpu_us_per_frame\": %.2f, "
+		 "\"glyph_cache_hit_rate\": %s}%s\n",
+		 workload.name, workload.buffered ? "true" : "false",
+		 (double) SimulatedLCD.getDataCount() / frames, (double) SimulatedLCD.getCommandCount() / frames,
+		 (double) SimulatedLCD.getPinChanges() / frames, elapsed / frames, libraryElapsed / frames, hitRate, i + 1 < count ? "," : "");
+     }
+
+     printf("  ]\n}\n");
+
+     return 0;
+}
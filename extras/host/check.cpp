@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Arduino.h>
+#include <LCD.h>
+#include "PCD8544.h"
+
+// Checks the asynchronous flush against the synchronous one. Two LCDs draw the same random
+// pictures through CaptureTransports: one flushes with flush(), the other with flushAsync(),
+// its transport stepped a random number of bytes at a time like an interrupt driven transport,
+// and drawn to between the steps when double buffered. The recorded bytes are replayed into a
+// PCD8544 model for each LCD, and both screens must show the screen buffer after every flush.
+// Usage: check [flushes]
+
+// The size of the capture buffers, enough for the bytes of a whole flush
+static const int CAPTURE_SIZE = 2048;
+
+// The asynchronous flushes completed, counted by the flush callback
+static int completed = 0;
+
+static void flushed()
+{
+     completed++;
+}
+
+// A random drawing, drawn the same way on every LCD
+struct Drawing
+{
+     int kind;
+     int x;
+     int y;
+     int width;
+     int height;
+     bool on;
+
+     Drawing()
+     {
+	  kind = rand() % 8;
+	  x = (rand() % 100) - 8;
+	  y = (rand() % 64) - 8;
+	  width = rand() % 40;
+	  height = rand() % 30;
+	  on = rand() % 2;
+     }
+
+     void draw(LCD &lcd)
+     {
+	  switch (kind) {
+	  case 0:
+	       lcd.fillRect(x, y, width, height, on);
+	       break;
+	  case 1:
+	       lcd.drawLine(x, y, x + width, y + height, on);
+	       break;
+	  case 2:
+	       lcd.writeString("ASYNC", x, y, 1 + (width % 2), on);
+	       break;
+	  case 3:
+	       lcd.drawCircle(x, y, width / 2, on);
+	       break;
+	  case 4:
+	       lcd.scrollRows((height % 5) - 2);
+	       break;
+	  case 5:
+	       lcd.scroll((width % 9) - 4, (height % 9) - 4);
+	       break;
+	  case 6:
+	       lcd.clear();
+	       break;
+	  default:
+	       lcd.drawPixel(x, y, on);
+	       break;
+	  }
+     }
+};
+
+// Replay the bytes recorded by the capture into the model, and forget them
+static void replay(CaptureTransport &capture, PCD8544 &model)
+{
+     if (capture.getDataCount() + capture.getCommandCount() > CAPTURE_SIZE) {
+	  fprintf(stderr, "Capture buffer too small\n");
+	  exit(1);
+     }
+
+     for (int i = 0; i < capture.getLength(); i++) {
+	  unsigned int entry = capture.getEntry(i);
+
+	  model.receive(entry & 0xFF, entry & CaptureTransport::DATA_FLAG);
+     }
+
+     capture.reset();
+}
+
+// Returns whether the model shows the screen buffer of the LCD, its rows put back in order
+static bool matches(LCD &lcd, PCD8544 &model)
+{
+     for (int row = 0; row < 6; row++) {
+	  const char *columns = lcd.getBuffer() + (((row + lcd.getRowOffset()) % 6) * 84);
+
+	  if (memcmp(columns, model.getRAM() + (row * 84), 84) != 0) {
+	       return false;
+	  }
+     }
+
+     return true;
+}
+
+int main(int argc, char **argv)
+{
+     int flushes = argc > 1 ? atoi(argv[1]) : 2000;
+     int failures = 0;
+
+     static unsigned int syncEntries[CAPTURE_SIZE];
+     static unsigned int asyncEntries[CAPTURE_SIZE];
+     CaptureTransport syncCapture(syncEntries, CAPTURE_SIZE);
+     CaptureTransport asyncCapture(asyncEntries, CAPTURE_SIZE);
+     LCD sync(syncCapture);
+     LCD async(asyncCapture);
+     PCD8544 syncModel;
+     PCD8544 asyncModel;
+
+     srand(1);
+
+     sync.init();
+     async.init();
+     sync.setAutoFlush(false);
+     async.setAutoFlush(false);
+     async.setFlushCallback(flushed);
+     asyncCapture.setStepped();
+
+     for (int i = 0; i < flushes; i++) {
+	  // Switch between sending the screen buffer and sending a copy of it now and then
+	  if (rand() % 50 == 0) {
+	       async.setDoubleBuffered(!async.isDoubleBuffered());
+	  }
+
+	  for (int count = rand() % 6; count > 0; count--) {
+	       Drawing drawing;
+
+	       drawing.draw(sync);
+	       drawing.draw(async);
+	  }
+
+	  sync.flush();
+	  replay(syncCapture, syncModel);
+
+	  int before = completed;
+	  bool drawn = false;
+
+	  if (!async.flushAsync()) {
+	       fprintf(stderr, "Flush %d: flushAsync failed\n", i);
+	       return 1;
+	  }
+
+	  // Step the transfer like the interrupts would, drawing to the back buffer meanwhile
+	  while (asyncCapture.step(1 + (rand() % 64))) {
+	       if (async.isDoubleBuffered() && rand() % 4 == 0) {
+		    Drawing drawing;
+
+		    drawing.draw(sync);
+		    drawing.draw(async);
+		    drawn = true;
+	       }
+	  }
+
+	  replay(asyncCapture, asyncModel);
+
+	  if (async.isFlushing() || completed != before + 1) {
+	       fprintf(stderr, "Flush %d: the flush callback was not called once\n", i);
+	       failures++;
+	  }
+
+	  if (!drawn && !matches(async, asyncModel)) {
+	       fprintf(stderr, "Flush %d: the asynchronous flush does not show the screen buffer\n", i);
+	       failures++;
+	  }
+
+	  // Both screens show what was flushed, drawing since then included only if sent
+	  sync.flush();
+	  replay(syncCapture, syncModel);
+	  async.flush();
+	  replay(asyncCapture, asyncModel);
+
+	  if (!matches(sync, syncModel) || !matches(async, asyncModel)) {
+	       fprintf(stderr, "Flush %d: the screen does not show the screen buffer\n", i);
+	       failures++;
+	  }
+
+	  if (memcmp(syncModel.getRAM(), asyncModel.getRAM(), LCD::BUFFER_SIZE) != 0) {
+	       fprintf(stderr, "Flush %d: the asynchronous flush differs from flush()\n", i);
+	       failures++;
+	  }
+     }
+
+     printf("%d asynchronous flushes checked, %d failures\n", flushes, failures);
+
+     return failures ? 1 : 0;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <Arduino.h>
+#include <LCD.h>
+#include "PCD8544.h"
+
+// Draws a test screen with the library and prints what the simulated screen shows
+// Usage: demo [image.pbm]
+
+int main(int argc, char **argv)
+{
+     LCD lcd;
+
+     if (!lcd.init()) {
+	  fprintf(stderr, "Cannot initialize the LCD\n");
+	  return 1;
+     }
+
+     lcd.setAutoFlush(false);
+
+     lcd.writeString("HOST", 18, 0, 2);
+     lcd.writeString("PCD8544 model", 3, 17);
+     lcd.drawRoundRect(0, 26, 84, 22, 4);
+     lcd.drawLine(4, 44, 40, 30);
+     lcd.drawCircle(62, 36, 8);
+     lcd.fillRect(58, 32, 9, 9);
+
+     lcd.flush();
+
+     SimulatedLCD.print();
+
+     if (argc > 1 && !SimulatedLCD.writePBM(argv[1], 4)) {
+	  fprintf(stderr, "Cannot write %s\n", argv[1]);
+	  return 1;
+     }
+
+     return 0;
+}
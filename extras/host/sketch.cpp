@@ -0,0 +1,34 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <Arduino.h>
+#include "PCD8544.h"
+
+// Runs an Arduino sketch on the computer: setup() once, then loop() a number of times,
+// and writes what the simulated screen shows at the end as a PBM image
+// Usage: sketch [image.pbm] [loops] [scale]
+
+void setup();
+void loop();
+
+int main(int argc, char **argv)
+{
+     const char *path = argc > 1 ? argv[1] : "screen.pbm";
+     long loops = argc > 2 ? atol(argv[2]) : 1;
+     int scale = argc > 3 ? atoi(argv[3]) : 4;
+
+     setup();
+
+     for (long i = 0; i < loops; i++) {
+	  loop();
+     }
+
+     if (!SimulatedLCD.writePBM(path, scale)) {
+	  fprintf(stderr, "Cannot write %s\n", path);
+	  return 1;
+     }
+
+     fprintf(stderr, "%s: %ld data bytes, %ld command bytes, %ld pin changes\n", path,
+	     SimulatedLCD.getDataCount(), SimulatedLCD.getCommandCount(), SimulatedLCD.getPinChanges());
+
+     return 0;
+}
@@ -0,0 +1,109 @@
+#include <Arduino.h>
+#include "Console.h"
+
+Console::Console(LCD &lcd)
+{
+     // Initialize the members of the Console class
+     m_lcd = &lcd;
+     m_column = 0;
+     m_line = 0;
+}
+
+size_t Console::write(uint8_t character)
+{
+     // A single character is written like any other characters
+     return write(&character, 1);
+}
+
+size_t Console::write(const uint8_t *buffer, size_t size)
+{
+     // Write every character without flushing, then flush the changes together
+     size_t count = 0;
+     bool autoflush = m_lcd->isAutoFlush();
+
+     m_lcd->setAutoFlush(false);
+
+     for (size_t i = 0; i < size; i++) {
+	  if (put(buffer[i])) {
+	       count++;
+	  }
+     }
+
+     m_lcd->setAutoFlush(autoflush);
+
+     if (autoflush) {
+	  m_lcd->flush();
+     }
+
+     return count;
+}
+
+void Console::clear()
+{
+     m_lcd->clear();
+
+     m_column = 0;
+     m_line = 0;
+}
+
+void Console::setCursor(int column, int line)
+{
+     // Make sure the cell is within the grid
+     m_column = constrain(column, 0, COLUMNS - 1);
+     m_line = constrain(line, 0, LINES - 1);
+}
+
+int Console::getColumn()
+{
+     return m_column;
+}
+
+int Console::getLine()
+{
+     return m_line;
+}
+
+bool Console::put(char character)
+{
+     // Handle the line control characters
+     if (character == '\n') {
+	  newLine();
+	  return true;
+     }
+
+     if (character == '\r') {
+	  m_column = 0;
+	  return true;
+     }
+
+     // Ignore the other control characters
+     if ((unsigned char) character < ' ') {
+	  return false;
+     }
+
+     // Wrap onto the next line only when there is a character to write there
+     if (m_column >= COLUMNS) {
+	  newLine();
+     }
+
+     char string[2] = { character, 0 };
+
+     // A whole cell is written, replacing the character that was there
+     m_lcd->writeString(string, m_column * 6, m_line * 8);
+     m_column++;
+
+     return true;
+}
+
+void Console::newLine()
+{
+     m_column = 0;
+
+     // On the last line, scroll up instead of moving down, clearing the new last line
+     if (m_line < LINES - 1) {
+	  m_line++;
+     }
+     else {
+	  m_lcd->scrollRows(1);
+     }
+}
@@ -0,0 +1,61 @@
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include <Print.h>
+#include "LCD.h"
+
+// Text console on a buffered LCD screen in landscape, written to like Serial with print and println
+// Characters are appended at a cursor moving over a grid of 14 columns and 6 lines of 6x8 cells,
+// sized for the default font. A line longer than the grid wraps onto the next line, and the
+// screen scrolls up a line when the cursor moves past the last one, with LCD::scrollRows.
+class Console : public Print
+{
+public:
+     // Size of the grid of characters
+     static const int COLUMNS = 14;
+     static const int LINES = 6;
+
+     // Create a console writing to the given LCD instance, which must outlive it
+     Console(LCD &lcd);
+
+     // Write a character at the cursor and move the cursor past it
+     // '\n' moves the cursor to the start of the next line, '\r' to the start of the line,
+     // other control characters are ignored. Returns 1 if written or handled, 0 otherwise.
+     // Flushes the changes if the LCD instance flushes automatically.
+     virtual size_t write(uint8_t character);
+
+     // Write size characters like write(character), flushing the changes once at the end
+     // Returns the number of characters written or handled.
+     virtual size_t write(const uint8_t *buffer, size_t size);
+
+     // The other ways of writing of Print
+     using Print::write;
+
+     // Clear the screen and move the cursor to the top left cell
+     void clear();
+
+     // Move the cursor to the given cell, clipped to the grid
+     void setCursor(int column, int line);
+
+     // Returns the column of the cursor, COLUMNS if the next character goes to the next line
+     int getColumn();
+
+     // Returns the line of the cursor
+     int getLine();
+
+private:
+     // The LCD instance written to
+     LCD *m_lcd;
+
+     // The cursor
+     int m_column;
+     int m_line;
+
+     // Write a character at the cursor without flushing
+     bool put(char character);
+
+     // Move the cursor to the start of the next line, scrolling if on the last one
+     void newLine();
+};
+
+#endif /* CONSOLE_H_ */
@@ -0,0 +1,187 @@
+#ifndef FASTTRANSPORT_H_
+#define FASTTRANSPORT_H_
+
+#include <Arduino.h>
+#include "Transport.h"
+#include "LCD.h"
+
+// On the ATmega328P and ATmega168 (Uno, Nano, Pro Mini) the port and bit of every pin are
+// known at compile time, so pins are toggled with single sbi/cbi instructions
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__)
+#define LCD_FAST_PINS_CONST
+#elif defined(__AVR__)
+#define LCD_FAST_PINS_RUNTIME
+#endif
+
+// The read-modify-write of a port register through a pointer is not atomic, so interrupts
+// are held off while the pins resolved at runtime are written
+#ifdef LCD_FAST_PINS_RUNTIME
+#define LCD_FAST_PINS_LOCK() uint8_t sreg = SREG; cli()
+#define LCD_FAST_PINS_UNLOCK() SREG = sreg
+#else
+#define LCD_FAST_PINS_LOCK()
+#define LCD_FAST_PINS_UNLOCK()
+#endif
+
+// A single output pin, written directly through its port register
+// Falls back to digitalWrite on boards without a known port layout
+template <int PIN>
+class FastPin
+{
+public:
+#ifdef LCD_FAST_PINS_CONST
+     static_assert(PIN >= 0 && PIN < 20, "FastPin only supports digital pins 0 to 19");
+#endif
+
+     // Set the pin as an output, and resolve its port register if needed
+     void begin()
+     {
+	  pinMode(PIN, OUTPUT);
+
+#ifdef LCD_FAST_PINS_RUNTIME
+	  m_port = portOutputRegister(digitalPinToPort(PIN));
+	  m_mask = digitalPinToBitMask(PIN);
+#endif
+     }
+
+     // Set the pin high
+     void high()
+     {
+#if defined(LCD_FAST_PINS_CONST)
+	  if (PIN < 8) {
+	       PORTD |= 1 << PIN;
+	  }
+	  else if (PIN < 14) {
+	       PORTB |= 1 << (PIN - 8);
+	  }
+	  else {
+	       PORTC |= 1 << (PIN - 14);
+	  }
+#elif defined(LCD_FAST_PINS_RUNTIME)
+	  *m_port |= m_mask;
+#else
+	  digitalWrite(PIN, HIGH);
+#endif
+     }
+
+     // Set the pin low
+     void low()
+     {
+#if defined(LCD_FAST_PINS_CONST)
+	  if (PIN < 8) {
+	       PORTD &= ~(1 << PIN);
+	  }
+	  else if (PIN < 14) {
+	       PORTB &= ~(1 << (PIN - 8));
+	  }
+	  else {
+	       PORTC &= ~(1 << (PIN - 14));
+	  }
+#elif defined(LCD_FAST_PINS_RUNTIME)
+	  *m_port &= ~m_mask;
+#else
+	  digitalWrite(PIN, LOW);
+#endif
+     }
+
+     // Set the pin high or low
+     void write(bool value)
+     {
+	  if (value) {
+	       high();
+	  }
+	  else {
+	       low();
+	  }
+     }
+
+private:
+#ifdef LCD_FAST_PINS_RUNTIME
+     // The port register and bit mask of the pin, resolved by begin()
+     volatile uint8_t *m_port;
+     uint8_t m_mask;
+#endif
+};
+
+// Bit-bang transport with the pins fixed at compile time
+// Toggles the pins through the port registers instead of digitalWrite
+template <int CLOCK_PIN = 2, int OUTPUT_PIN = 3, int TYPE_PIN = 4, int ENABLE_PIN = 5>
+class FastBitBangTransport : public Transport
+{
+public:
+     // Set up the pins used by the transport, leaving the chip disabled
+     virtual void begin()
+     {
+	  m_clock.begin();
+	  m_clock.low();
+
+	  m_output.begin();
+	  m_output.low();
+
+	  m_type.begin();
+	  m_type.low();
+
+	  m_enable.begin();
+	  m_enable.high();
+     }
+
+     // Enable the chip for a transfer of data bytes, or command bytes
+     virtual void select(bool data)
+     {
+	  LCD_FAST_PINS_LOCK();
+
+	  // Set the chip to look for clock cycles
+	  m_enable.low();
+	  // Set the byte type
+	  m_type.write(data);
+
+	  LCD_FAST_PINS_UNLOCK();
+     }
+
+     // Send a single byte, one bit at a time, starting with the high bit
+     virtual void transfer(char byte)
+     {
+	  LCD_FAST_PINS_LOCK();
+
+	  for (unsigned char mask = 0x80; mask; mask >>= 1) {
+	       m_clock.low();
+	       m_output.write(byte & mask);
+	       m_clock.high();
+	  }
+
+	  LCD_FAST_PINS_UNLOCK();
+     }
+
+     // Disable the chip at the end of a transfer
+     virtual void deselect()
+     {
+	  LCD_FAST_PINS_LOCK();
+
+	  // Set the chip to ignore clock cycles
+	  m_enable.high();
+
+	  LCD_FAST_PINS_UNLOCK();
+     }
+
+private:
+     // The pins of the transport
+     FastPin<CLOCK_PIN> m_clock;
+     FastPin<OUTPUT_PIN> m_output;
+     FastPin<TYPE_PIN> m_type;
+     FastPin<ENABLE_PIN> m_enable;
+};
+
+// LCD driven through a FastBitBangTransport, with the same API as the LCD class
+// The pins default to those of the LCD4884 shield: FastLCD<> lcd;
+template <int CLOCK_PIN = 2, int OUTPUT_PIN = 3, int TYPE_PIN = 4, int ENABLE_PIN = 5>
+class FastLCD : private FastBitBangTransport<CLOCK_PIN, OUTPUT_PIN, TYPE_PIN, ENABLE_PIN>, public LCD
+{
+public:
+     // Create an instance of the LCD class on the compile time pins
+     FastLCD(int reset = 6, int backlight = 7)
+	  : LCD(*static_cast<Transport *>(this), reset, backlight)
+     {
+     }
+};
+
+#endif /* FASTTRANSPORT_H_ */
@@ -1,3 +1,4 @@
+#include <string.h>
 #include <avr/pgmspace.h>
 #include "Font.h"
 
@@ -260,8 +261,12 @@ Font::Font()
      // Initialize members to defaults (for DEFAULT_FONT)
      m_font = (char *) DEFAULT_FONT;
      m_width = 6;
+     m_rows = 1;
      m_chars = 243;
      m_offset = 1;
+     m_glyphs = 0;
+     m_kerning = 0;
+     m_kernings = 0;
 }
 
 #endif /* NO_DEFAULT_FONT */
@@ -271,13 +276,53 @@ Font::Font()
 // to the 2D font array, the number of characters in the
 // font, the width of the font characters, and the
 // offset of where the font starts.
-Font::Font(const char *font, int characters, int width, int offset)
+Font::Font(const char *font, int characters, int width, int offset, int height)
 {
      // Initialize the members for custom fonts
      m_font = font;
      m_width = width;
+     m_rows = height > 8 ? (height + 7) / 8 : 1;
      m_chars = characters;
      m_offset = offset;
+     m_glyphs = 0;
+     m_kerning = 0;
+     m_kernings = 0;
+}
+
+// This constructor initializes a proportional font with
+// the parameters provided. The arguments are a pointer
+// to the font columns, a pointer to the glyph table, the
+// number of characters in the font, and the offset of
+// where the font starts.
+Font::Font(const char *font, const Glyph *glyphs, int characters, int offset, int height)
+{
+     // Initialize the members for proportional fonts
+     m_font = font;
+     m_rows = height > 8 ? (height + 7) / 8 : 1;
+     m_glyphs = glyphs;
+     m_chars = characters;
+     m_offset = offset;
+     m_kerning = 0;
+     m_kernings = 0;
+
+     // The font width is the width of the widest character
+     m_width = 0;
+
+     for (int i = 0; i < characters; i++) {
+	  int width = pgm_read_byte(&glyphs[i].width);
+
+	  if (width > m_width) {
+	       m_width = width;
+	  }
+     }
+}
+
+// Sets the kerning pairs of the font, sorted by left
+// character then right character.
+void Font::setKerning(const KerningPair *pairs, int count)
+{
+     m_kerning = pairs;
+     m_kernings = count;
 }
 
 // Overload the default array operator so that Font
@@ -294,6 +339,72 @@ int Font::getWidth()
      return m_width;
 }
 
+// Returns the width of the character 'which'.
+int Font::getCharWidth(int which)
+{
+     // Every character of a fixed width font has the same width
+     if (!m_glyphs) {
+	  return m_width;
+     }
+
+     // Offset the character being accessed
+     which = which - m_offset;
+
+     // Check the bounds, if out of bounds, return 0
+     if (which < 0 || which >= m_chars) {
+	  return 0;
+     }
+
+     return pgm_read_byte(&m_glyphs[which].width);
+}
+
+// Returns the change of the advance between the
+// characters 'left' and 'right'.
+int Font::getKerning(int left, int right)
+{
+     int low = 0;
+     int high = m_kernings - 1;
+     unsigned int key = ((unsigned char) left << 8) | (unsigned char) right;
+
+     // Binary search the sorted kerning pairs
+     while (low <= high) {
+	  int middle = (low + high) / 2;
+	  const KerningPair *pair = m_kerning + middle;
+	  unsigned int current = (pgm_read_byte(&pair->left) << 8) | pgm_read_byte(&pair->right);
+
+	  if (current == key) {
+	       return (signed char) pgm_read_byte(&pair->adjust);
+	  }
+
+	  if (current < key) {
+	       low = middle + 1;
+	  }
+	  else {
+	       high = middle - 1;
+	  }
+     }
+
+     return 0;
+}
+
+// Returns whether the characters have their own widths.
+bool Font::isProportional()
+{
+     return m_glyphs != 0;
+}
+
+// Returns the height of the font characters.
+int Font::getHeight()
+{
+     return m_rows * 8;
+}
+
+// Returns the number of bytes of a column.
+int Font::getRows()
+{
+     return m_rows;
+}
+
 // Returns the start offset of the font.
 int Font::getOffset()
 {
@@ -308,17 +419,57 @@ int Font::getCharacterCount()
 
 // Returns the column 'index' from the character 'which'.
 char Font::getCharColumn(int which, int index)
+{
+     return getCharColumn(which, index, 0);
+}
+
+// Returns the byte on the row 'row' of the column 'index'
+// from the character 'which'.
+char Font::getCharColumn(int which, int index, int row)
 {
      // Offset the character being accessed
      which = which - m_offset;
 
      // Check the bounds, if out of bounds, return 0
-     if (which < 0 || index < 0 || which >= m_chars || index >= m_width) {
+     if (which < 0 || index < 0 || row < 0 || which >= m_chars || row >= m_rows || index >= getCharWidth(which + m_offset)) {
 	  return 0;
      }
 
      // Return the column for the character from the progmem area
-     return pgm_read_byte(m_font + (which * m_width) + index);
+     return pgm_read_byte(m_font + ((getCharStart(which) + index) * m_rows) + row);
+}
+
+// Copies the columns of the character 'which' into 'columns'.
+void Font::getChar(int which, char *columns)
+{
+     // Offset the character being accessed
+     which = which - m_offset;
+
+     // Check the bounds, if out of bounds, copy 0s
+     if (which < 0 || which >= m_chars) {
+	  memset(columns, 0, getCharWidth(which + m_offset) * m_rows);
+	  return;
+     }
+
+     // Copy the columns for the character from the progmem area
+     memcpy_P(columns, m_font + (getCharStart(which) * m_rows), getCharWidth(which + m_offset) * m_rows);
+}
+
+// Returns the index of the first column of the character
+// 'which', already offset, in the font data.
+int Font::getCharStart(int which)
+{
+     if (m_glyphs) {
+	  return pgm_read_word(&m_glyphs[which].offset);
+     }
+
+     return which * m_width;
+}
+
+// Returns the pointer to the font data.
+const char *Font::getData()
+{
+     return m_font;
 }
 
 // Font wrapper to allow fonts to be used as 2D arrays.
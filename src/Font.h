@@ -12,6 +12,26 @@ extern const char DEFAULT_FONT[][6];
 class Font
 {
 public:
+     // Entry of the glyph table of a proportional font, stored in
+     // program memory. The offset is the index of the first column
+     // of the character in the font data, the width its number of
+     // columns.
+     struct Glyph
+     {
+	  unsigned short offset;
+	  unsigned char width;
+     };
+
+     // Kerning pair of a proportional font, stored in program
+     // memory. The advance from the left character to the right
+     // one is changed by adjust columns.
+     struct KerningPair
+     {
+	  unsigned char left;
+	  unsigned char right;
+	  signed char adjust;
+     };
+
      // Font wrapper to be able to use fonts as 2D arrays
      class FontWrapper
      {
@@ -45,15 +65,52 @@ public:
      // This constructor initializes the font to be used with
      // the parameters provided. The arguments are a pointer to
      // the 2D font array, the number of characters in the font,
-     // the width of the font characters, and the offset of
-     // where the font starts.
-     Font(const char *font, int characters, int width, int offset = 0);
+     // the width of the font characters, the offset of where
+     // the font starts, and the height of the characters in
+     // pixels. Characters taller than 8 pixels span several
+     // screen rows, with a byte per row in every column: the
+     // bytes of a column follow each other from the top one.
+     Font(const char *font, int characters, int width, int offset = 0, int height = 8);
+
+     // This constructor initializes a proportional font. The
+     // arguments are a pointer to the font data, holding the
+     // columns of the characters one after the other, a pointer
+     // to the glyph table with an entry per character, the
+     // number of characters, the offset of where the font
+     // starts, and the height of the characters in pixels,
+     // laid out like the fixed width fonts. Both tables are in
+     // program memory.
+     Font(const char *font, const Glyph *glyphs, int characters, int offset = 0, int height = 8);
+
+     // Set the kerning pairs of the font, in program memory and
+     // sorted by left character then right character.
+     void setKerning(const KerningPair *pairs, int count);
      
      // First dimension
      FontWrapper operator[](int index);
      
-     // Returns the width of a single character
+     // Returns the width of a single character, the widest one
+     // for proportional fonts
      int getWidth();
+
+     // Returns the width of the character 'which', 0 if out of
+     // bounds of a proportional font
+     int getCharWidth(int which);
+
+     // Returns the change of the advance from the character
+     // 'left' to the character 'right', 0 if not a kerning pair
+     int getKerning(int left, int right);
+
+     // Returns whether the characters have their own widths
+     bool isProportional();
+
+     // Returns the height of the characters in pixels, a
+     // multiple of 8
+     int getHeight();
+
+     // Returns the number of bytes of a column, the number of
+     // screen rows a character spans
+     int getRows();
      
      // Returns the offset of the character set
      int getOffset();
@@ -61,12 +118,28 @@ public:
      // Returns the number of characters in the font
      int getCharacterCount();
      
-     // Returns a single column for a character in the font
+     // Returns a single column for a character in the font, its
+     // top byte for characters spanning several screen rows
      char getCharColumn(int which, int index);
+
+     // Returns the byte of a column for a character in the font
+     // on the screen row 'row' of the character
+     char getCharColumn(int which, int index, int row);
+
+     // Copies all the columns of a character into columns, which
+     // must hold getCharWidth(which) * getRows() bytes. Copies
+     // 0s if out of bounds.
+     void getChar(int which, char *columns);
+
+     // Returns the pointer to the font data, identifying the font
+     const char *getData();
      
 private:
      // The width of a character
      int m_width;
+
+     // The number of bytes of a column
+     int m_rows;
      
      // The font offset
      int m_offset;
@@ -76,6 +149,97 @@ private:
      
      // The font pointer
      const char *m_font;
+
+     // The glyph table of a proportional font, 0 if fixed width
+     const Glyph *m_glyphs;
+
+     // The kerning pairs, and their number
+     const KerningPair *m_kerning;
+     int m_kernings;
+
+     // Returns the index of the first column of the character
+     // 'which' (already offset) in the font data
+     int getCharStart(int which);
+};
+
+// Fixed width font with its metrics known at compile time, as
+// template parameters: the width and the height of the
+// characters, the first character, and the number of
+// characters. The font data is laid out like the data of a
+// fixed width Font, in program memory, with (HEIGHT + 7) / 8
+// bytes per column. Writing with
+// LCD::writeString(FixedFont, ...) folds the address of a
+// character and its bounds check into a single comparison and
+// an indexed read of program memory.
+template <int WIDTH, int HEIGHT, int FIRST, int COUNT>
+class FixedFont
+{
+public:
+     static_assert(WIDTH > 0 && HEIGHT > 0 && COUNT > 0, "FixedFont needs characters at least a pixel wide and high");
+
+     // The number of bytes of a column
+     static const int ROWS = (HEIGHT + 7) / 8;
+
+     // This constructor initializes the font with the pointer
+     // to its data, in program memory.
+     constexpr FixedFont(const char *font) : m_font(font)
+     {
+     }
+
+     // Returns the width of a character.
+     constexpr int getWidth() const
+     {
+	  return WIDTH;
+     }
+
+     // Returns the height of a character.
+     constexpr int getHeight() const
+     {
+	  return HEIGHT;
+     }
+
+     // Returns the offset of the character set.
+     constexpr int getOffset() const
+     {
+	  return FIRST;
+     }
+
+     // Returns the number of characters in the font.
+     constexpr int getCharacterCount() const
+     {
+	  return COUNT;
+     }
+
+     // Returns the address in program memory of the columns
+     // of the character 'which', 0 if out of bounds.
+     const char *getChar(int which) const
+     {
+	  // Both bounds are checked by a single unsigned comparison
+	  unsigned int index = which - FIRST;
+
+	  return index < (unsigned int) COUNT ? m_font + (index * WIDTH * ROWS) : 0;
+     }
+
+     // Returns the same font as a runtime Font, for
+     // LCD::setFont and the functions taking a Font.
+     Font toFont() const
+     {
+	  return Font(m_font, COUNT, WIDTH, FIRST, HEIGHT);
+     }
+
+private:
+     // The font pointer
+     const char *m_font;
 };
 
+#ifndef NO_DEFAULT_FONT
+
+// The default font as a FixedFont, 6x8 characters from
+// character 1
+typedef FixedFont<6, 8, 1, 243> DefaultFixedFont;
+
+constexpr DefaultFixedFont DEFAULT_FIXED_FONT(DEFAULT_FONT[0]);
+
+#endif /* NO_DEFAULT_FONT */
+
 #endif /* FONT_H_ */
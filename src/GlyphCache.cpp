@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include <string.h>
+#include "Font.h"
+#include "GlyphCache.h"
+
+// Where the characters of each font start, in quarters of the slots: the first
+// two fonts are half the slots apart, the next two in between
+static const unsigned char FONT_START[GlyphCache::FONTS] = { 0, 2, 1, 3 };
+
+GlyphCache::GlyphCache(int slots, int glyphSize)
+{
+     // Allocate the keys, their fonts and the glyphs in one block
+     m_keys = (unsigned char *) malloc(slots * (glyphSize + 2));
+
+     if (!m_keys) {
+	  slots = 0;
+     }
+
+     m_owners = m_keys + slots;
+     m_glyphs = (char *) (m_owners + slots);
+     m_slots = slots;
+     m_glyphSize = glyphSize;
+
+     clear();
+     resetCounters();
+}
+
+GlyphCache::~GlyphCache()
+{
+     free(m_keys);
+}
+
+const char *GlyphCache::getGlyph(Font &font, int which)
+{
+     // Glyphs that do not fit are never cached, neither is character 0 which marks empty slots
+     if (font.getWidth() * font.getRows() > m_glyphSize || m_slots == 0 || (unsigned char) which == 0) {
+	  return 0;
+     }
+
+     // Each font starts a fraction of the slots further, so the same characters
+     // of two fonts do not take the same slots
+     int index = findFont(font);
+     int slot = ((unsigned char) which + ((FONT_START[index] * m_slots) / 4)) % m_slots;
+     char *glyph = m_glyphs + (slot * m_glyphSize);
+
+     if (m_keys[slot] == (unsigned char) which && m_owners[slot] == index) {
+	  m_hits++;
+	  return glyph;
+     }
+
+     // Copy the glyph from the font
+     m_misses++;
+     font.getChar((unsigned char) which, glyph);
+     m_keys[slot] = (unsigned char) which;
+     m_owners[slot] = index;
+
+     return glyph;
+}
+
+void GlyphCache::clear()
+{
+     // Mark every slot empty
+     if (m_keys) {
+	  memset(m_keys, 0, m_slots);
+     }
+
+     // Forget the fonts
+     for (int i = 0; i < FONTS; i++) {
+	  m_fonts[i].data = 0;
+     }
+
+     m_nextFont = 0;
+}
+
+int GlyphCache::findFont(Font &font)
+{
+     FontKey key;
+
+     key.data = font.getData();
+     key.offset = font.getOffset();
+     key.characters = font.getCharacterCount();
+     key.width = font.getWidth();
+     key.rows = font.getRows();
+
+     for (int i = 0; i < FONTS; i++) {
+	  const FontKey &entry = m_fonts[i];
+
+	  if (entry.data == key.data && entry.offset == key.offset && entry.characters == key.characters
+	      && entry.width == key.width && entry.rows == key.rows) {
+	       return i;
+	  }
+     }
+
+     // Take over the entry of the font added the longest ago, dropping its glyphs
+     int index = m_nextFont;
+
+     m_nextFont = (m_nextFont + 1) % FONTS;
+     m_fonts[index] = key;
+
+     for (int slot = 0; slot < m_slots; slot++) {
+	  if (m_owners[slot] == index) {
+	       m_keys[slot] = 0;
+	  }
+     }
+
+     return index;
+}
+
+unsigned long GlyphCache::getHits()
+{
+     return m_hits;
+}
+
+unsigned long GlyphCache::getMisses()
+{
+     return m_misses;
+}
+
+void GlyphCache::resetCounters()
+{
+     m_hits = 0;
+     m_misses = 0;
+}
@@ -0,0 +1,83 @@
+#ifndef GLYPHCACHE_H_
+#define GLYPHCACHE_H_
+
+#include "Font.h"
+
+// Cache of whole glyphs copied to RAM from fonts in program memory
+// Each character goes to a single slot (its code modulo the number of slots),
+// so consecutive characters like digits never evict each other. The glyphs of
+// up to FONTS fonts are kept at once, each font's characters starting a
+// fraction of the slots further, so screens switching fonts keep their hits.
+class GlyphCache
+{
+public:
+     // Number of fonts whose glyphs are kept at once
+     static const int FONTS = 4;
+
+     // Create a cache of the given number of slots, each holding a glyph
+     // of up to glyphSize bytes, a byte per column of each screen row the
+     // characters span (Font::getRows). Allocates slots * (glyphSize + 2) bytes;
+     // if that fails the cache holds nothing and every lookup misses.
+     GlyphCache(int slots = 16, int glyphSize = 6);
+
+     // Free the cache memory
+     ~GlyphCache();
+
+     // Returns the columns of a character of the font, copying them to the
+     // cache on a miss. Returns 0 if the glyph is larger than the slots.
+     // Fonts are told apart by their data, first character, number of
+     // characters, width and height, not by the Font instance.
+     const char *getGlyph(Font &font, int which);
+
+     // Forget all the cached glyphs and fonts
+     void clear();
+
+     // Returns the number of lookups found in the cache
+     unsigned long getHits();
+
+     // Returns the number of lookups that had to read the font
+     unsigned long getMisses();
+
+     // Reset the hit and miss counters
+     void resetCounters();
+
+private:
+     // What tells the glyphs of a font apart from those of another
+     struct FontKey
+     {
+	  const char *data; // 0 if the entry is unused
+	  int offset;
+	  int characters;
+	  int width;
+	  int rows;
+     };
+
+     // Copies are not allowed, the cache memory belongs to a single instance
+     GlyphCache(const GlyphCache &);
+     GlyphCache &operator=(const GlyphCache &);
+
+     // Returns the index of the font in m_fonts, taking over the entry of the
+     // font added the longest ago and dropping its glyphs if not there
+     int findFont(Font &font);
+
+     // The glyph columns, glyphSize bytes per slot
+     char *m_glyphs;
+
+     // The character held by each slot, 0 if empty, and the index of its font
+     unsigned char *m_keys;
+     unsigned char *m_owners;
+
+     // The cache dimensions
+     int m_slots;
+     int m_glyphSize;
+
+     // The fonts the cached glyphs belong to, and the entry taken over next
+     FontKey m_fonts[FONTS];
+     int m_nextFont;
+
+     // The lookup counters
+     unsigned long m_hits;
+     unsigned long m_misses;
+};
+
+#endif /* GLYPHCACHE_H_ */
@@ -3,50 +3,232 @@
 #include "Font.h"
 #include "LCD.h"
 
+#ifdef LCD_STATS
+// Adds the time from its creation to its destruction to a counter of the statistics, unless
+// a caller is already adding to it. The time added to the other counter meanwhile is left out,
+// so the time spent drawing does not include the flushes it triggers, and the other way around.
+class StatsTimer
+{
+public:
+     StatsTimer(unsigned long &total, bool &running, unsigned long &other)
+     {
+	  m_total = &total;
+	  m_running = &running;
+	  m_other = &other;
+	  m_counting = !running;
+	  m_start = micros();
+	  m_otherStart = other;
+
+	  running = true;
+     }
+
+     ~StatsTimer()
+     {
+	  if (m_counting) {
+	       *m_total += (micros() - m_start) - (*m_other - m_otherStart);
+	       *m_running = false;
+	  }
+     }
+
+private:
+     unsigned long *m_total;
+     bool *m_running;
+     unsigned long *m_other;
+     bool m_counting;
+     unsigned long m_start;
+     unsigned long m_otherStart;
+};
+
+#define LCD_STATS_ADD(counter, count) m_stats.counter += (count)
+#define LCD_STATS_RENDER() StatsTimer statsTimer(m_stats.renderMicros, m_statsRender, m_stats.transferMicros)
+#define LCD_STATS_TRANSFER() StatsTimer statsTimer(m_stats.transferMicros, m_statsTransfer, m_stats.renderMicros)
+#else
+#define LCD_STATS_ADD(counter, count)
+#define LCD_STATS_RENDER()
+#define LCD_STATS_TRANSFER()
+#endif
+
+// Bits of a nibble doubled, for columns scaled by 2
+static const unsigned char SCALE_2[16] PROGMEM = {
+     0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+     0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
+// Bits of a nibble tripled, for columns scaled by 3
+static const uint16_t SCALE_3[16] PROGMEM = {
+     0x000, 0x007, 0x038, 0x03F, 0x1C0, 0x1C7, 0x1F8, 0x1FF,
+     0xE00, 0xE07, 0xE38, 0xE3F, 0xFC0, 0xFC7, 0xFF8, 0xFFF
+};
+
+// Bits of a pair quadrupled, for columns scaled by 4
+static const unsigned char SCALE_4[4] PROGMEM = {
+     0x00, 0x0F, 0xF0, 0xFF
+};
+
+// Bits of a nibble repeated 5 times, for columns scaled by 5
+static const uint32_t SCALE_5[16] PROGMEM = {
+     0x00000, 0x0001F, 0x003E0, 0x003FF, 0x07C00, 0x07C1F, 0x07FE0, 0x07FFF,
+     0xF8000, 0xF801F, 0xF83E0, 0xF83FF, 0xFFC00, 0xFFC1F, 0xFFFE0, 0xFFFFF
+};
+
+// Expand the bits of a column by scale, 1 to 6 or 8, into scale bytes from the top one
+// Returns false for the other scales
+static bool expandColumn(unsigned char bits, int scale, unsigned char *expanded)
+{
+     uint32_t low;
+     uint32_t high;
+     unsigned char thirds[3];
+
+     switch (scale) {
+     case 1:
+	  expanded[0] = bits;
+	  return true;
+     case 2:
+	  expanded[0] = pgm_read_byte(SCALE_2 + (bits & 0x0F));
+	  expanded[1] = pgm_read_byte(SCALE_2 + (bits >> 4));
+	  return true;
+     case 3:
+	  // 12 bits from each nibble
+	  low = pgm_read_word(SCALE_3 + (bits & 0x0F)) | ((uint32_t) pgm_read_word(SCALE_3 + (bits >> 4)) << 12);
+
+	  expanded[0] = low;
+	  expanded[1] = low >> 8;
+	  expanded[2] = low >> 16;
+	  return true;
+     case 4:
+	  for (int i = 0; i < 4; i++) {
+	       expanded[i] = pgm_read_byte(SCALE_4 + ((bits >> (i * 2)) & 0x03));
+	  }
+
+	  return true;
+     case 5:
+	  // 20 bits from each nibble, sharing the middle byte
+	  low = pgm_read_dword(SCALE_5 + (bits & 0x0F));
+	  high = pgm_read_dword(SCALE_5 + (bits >> 4));
+
+	  expanded[0] = low;
+	  expanded[1] = low >> 8;
+	  expanded[2] = (low >> 16) | (high << 4);
+	  expanded[3] = high >> 4;
+	  expanded[4] = high >> 12;
+	  return true;
+     case 6:
+	  // Scaled by 3, then every byte scaled by 2
+	  expandColumn(bits, 3, thirds);
+
+	  for (int i = 0; i < 3; i++) {
+	       expandColumn(thirds[i], 2, expanded + (i * 2));
+	  }
+
+	  return true;
+     case 8:
+	  for (int i = 0; i < 8; i++) {
+	       expanded[i] = (bits >> i) & 1 ? 0xFF : 0;
+	  }
+
+	  return true;
+     default:
+	  return false;
+     }
+}
+
+// One corner of the pixels of a column scaled by 2 the Scale2x way, for all its pixels at once:
+// the corner takes the color of the neighbors a and b on its sides where they match,
+// and differ from the neighbors opposite them, and the color of the pixel otherwise
+static unsigned char smoothCorner(unsigned char pixels, unsigned char a, unsigned char b, unsigned char oppositeA, unsigned char oppositeB)
+{
+     unsigned char mask = ~(a ^ b) & (a ^ oppositeB) & (b ^ oppositeA);
+
+     return (a & mask) | (pixels & ~mask);
+}
+
+// Interleave the bits of the top and bottom corners of 4 pixels, into a byte of the column scaled by 2
+static unsigned char interleave(unsigned char top, unsigned char bottom)
+{
+     return (pgm_read_byte(SCALE_2 + (top & 0x0F)) & 0x55) | (pgm_read_byte(SCALE_2 + (bottom & 0x0F)) & 0xAA);
+}
+
+// Bits of a nibble in reverse order, for columns drawn upside down
+static const unsigned char REVERSE_4[16] PROGMEM = {
+     0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+     0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
+
+// Reverse the bits of a column, the top pixel becomes the bottom one
+static unsigned char reverseBits(unsigned char bits)
+{
+     return (pgm_read_byte(REVERSE_4 + (bits & 0x0F)) << 4) | pgm_read_byte(REVERSE_4 + (bits >> 4));
+}
+
+// Transpose a block of 8 columns in place, bit j of column i becomes bit i of column j
+// Swaps 1x1, then 2x2, then 4x4 squares of bits across the diagonal, 32 bits at a time
+static void transpose(unsigned char *block)
+{
+     uint32_t x = block[4] | ((uint32_t) block[5] << 8) | ((uint32_t) block[6] << 16) | ((uint32_t) block[7] << 24);
+     uint32_t y = block[0] | ((uint32_t) block[1] << 8) | ((uint32_t) block[2] << 16) | ((uint32_t) block[3] << 24);
+     uint32_t t;
+
+     t = (x ^ (x >> 7)) & 0x00AA00AA;
+     x = x ^ t ^ (t << 7);
+     t = (y ^ (y >> 7)) & 0x00AA00AA;
+     y = y ^ t ^ (t << 7);
+
+     t = (x ^ (x >> 14)) & 0x0000CCCC;
+     x = x ^ t ^ (t << 14);
+     t = (y ^ (y >> 14)) & 0x0000CCCC;
+     y = y ^ t ^ (t << 14);
+
+     t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+     y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+     x = t;
+
+     for (int i = 0; i < 4; i++) {
+	  block[i] = y >> (i * 8);
+	  block[i + 4] = x >> (i * 8);
+     }
+}
+
 LCD::LCD(int clock, int output, int type, int enable, int reset, int backlight)
+     : m_bitbang(clock, output, type, enable)
 {
      // Initialize the members of the LCD class
-     m_clock = clock;
-     m_output = output;
-     m_type = type;
-     m_enable = enable;
+     m_transport = 0;
      m_reset = reset;
      m_backlight = backlight;
 
-     m_screen = 0;
-     m_autoflush = true;
-     m_wrapstyle = WRAP_RETURN;
-     m_font = Font();
+     setDefaults();
 }
 
-bool LCD::init(bool buffered)
+LCD::LCD(Transport &transport, int reset, int backlight)
 {
-     // Initialize all the pins to low (including reset and enable, which are active LOW)
-     // RESET signal needs to be sent within 100 ms of power being applied to the LCD controller
-     pinMode(m_clock, OUTPUT);
-     digitalWrite(m_clock, LOW);
-
-     pinMode(m_output, OUTPUT);
-     digitalWrite(m_output, LOW);
-
-     pinMode(m_type, OUTPUT);
-     digitalWrite(m_type, LOW);
+     // Initialize the members of the LCD class
+     m_transport = &transport;
+     m_reset = reset;
+     m_backlight = backlight;
 
-     pinMode(m_enable, OUTPUT);
-     digitalWrite(m_enable, LOW);
+     setDefaults();
+}
 
+bool LCD::init(bool buffered)
+{
+     // Initialize the reset and backlight pins to low (reset is active LOW)
+     // RESET signal needs to be sent within 100 ms of power being applied to the LCD controller
      pinMode(m_reset, OUTPUT);
      digitalWrite(m_reset, LOW);
 
      pinMode(m_backlight, OUTPUT);
      digitalWrite(m_backlight, LOW);
 
+     // Initialize the transport pins
      // Reset function:
-     // enable pin must be high when the reset pin goes high
-     digitalWrite(m_enable, HIGH);
+     // enable pin must be high when the reset pin goes high, the transport leaves it high
+     getTransport()->begin();
      delay(100);
      digitalWrite(m_reset, HIGH);
 
+     // Whatever the controller was told before the reset is gone
+     forgetState();
+
      // Initialize the options
      setBiasSystem(BS_1_48);
      setOperatingVoltage(16);
@@ -68,31 +250,35 @@ bool LCD::init(bool buffered)
 
 void LCD::clear()
 {
+     LCD_STATS_RENDER();
+
      // If not buffered, write all 0s
      if (!m_screen) {
+	  LCD_STATS_TRANSFER();
+
 	  // Set the screen settings for output
 	  set(false, false, false);
 
 	  // Set the cursor to (0, 0)
-	  writeByte(0x80, COMMAND_BYTE); // X
-	  writeByte(0x40, COMMAND_BYTE); // Y
+	  setCursor(0, 0);
 
 	  // Clear screen
-	  for (int i = 0; i < 6; i++) {
-	       for (int j = 0; j < 84; j++) {
-		    writeByte(0, DATA_BYTE);
-	       }
+	  select(true);
+
+	  for (int i = 0; i < 504; i++) {
+	       transfer(0);
 	  }
 
+	  getTransport()->deselect();
+
 	  return;
      }
 
-     // If buffered, clear the screen buffer
-     for (int i = 0; i < 6; i++) {
-	  for (int j = 0; j < 84; j++) {
-	       m_screen[i][j] = 0;
-	  }
-     }
+     // If buffered, clear the screen buffer, or the strip being rendered, back in row order
+     memset(m_screen, 0, m_stripRows * 84);
+     m_rowOffset = 0;
+
+     setDirty(true);
 
      // Flush to the screen
      if (m_autoflush) {
@@ -102,70 +288,320 @@ void LCD::clear()
 
 void LCD::flush()
 {
+     unsigned char first[6];
+     unsigned char last[6];
+
+     LCD_STATS_TRANSFER();
+
      // If not buffered, and flushing screen, do nothing
-     if (!m_screen) {
+     // While rendering, render() sends every strip once drawn
+     if (!m_screen || m_rendering) {
+	  return;
+     }
+
+     // Let an asynchronous flush finish first, so it does not overwrite newer contents
+     waitFlush();
+
+     // Nothing changed since the last flush
+     if (!takeDirty(first, last)) {
 	  return;
      }
 
-     // If not buffered, and not flusning screen (flushing with 0s instead)
-     // Or if buffered and flushing screen
+     LCD_STATS_ADD(flushes, 1);
 
      // Set the screen settings for output
      set(false, false, false);
 
-     // Set the cursor to (0, 0)
-     writeByte(0x80, COMMAND_BYTE); // X
-     writeByte(0x40, COMMAND_BYTE); // Y
+     // Write the changed spans
+     for (int i = 0; i < 6; ) {
+	  int start;
+	  int count;
 
-     // Write screen bytes
-     for (int i = 0; i < 6; i++) {
-	  for (int j = 0; j < 84; j++) {
-	       writeByte(m_screen[i][j], DATA_BYTE);
+	  if (!nextSpan(first, last, m_rowOffset, i, start, count)) {
+	       break;
 	  }
+
+	  setCursor(start % 84, start / 84);
+	  writeBytes(m_screen + rotate(start, m_rowOffset), count);
      }
 }
 
-bool LCD::setBuffered(bool buffered)
+bool LCD::flushAsync()
 {
-     if (!buffered && m_screen) {
-	  // Free the screen pointer if going from buffered to not buffered
-	  for (int i = 0; i < 6; i++) {
-	       free(m_screen[i]);
-	       m_screen[i] = 0;
+     LCD_STATS_TRANSFER();
+
+     // Only buffered output can be flushed, one flush at a time
+     if (!m_screen || m_flushing || m_rendering) {
+	  return false;
+     }
+
+     // Take the changed spans, changes made from now on go to the next flush
+     if (!takeDirty(m_flushFirst, m_flushLast)) {
+	  if (m_flushcallback) {
+	       m_flushcallback();
 	  }
 
-	  free(m_screen);
-	  m_screen = 0;
+	  return true;
+     }
+
+     LCD_STATS_ADD(flushes, 1);
+
+     // Copy the changed spans to the front buffer, so drawing can go on during the transfer
+     if (m_front) {
+	  for (int i = 0; i < 6; ) {
+	       int start;
+	       int count;
+
+	       if (!nextSpan(m_flushFirst, m_flushLast, m_rowOffset, i, start, count)) {
+		    break;
+	       }
+
+	       memcpy(m_front + rotate(start, m_rowOffset), m_screen + rotate(start, m_rowOffset), count);
+	  }
+     }
+
+     // Set the screen settings for output
+     set(false, false, false);
+
+     // Start sending the first span, the next ones are started as each one completes
+     m_flushing = true;
+     m_flushrow = 0;
+     m_flushOffset = m_rowOffset;
+
+     flushNext(this);
+
+     return true;
+}
+
+bool LCD::isFlushing()
+{
+     // Return if an asynchronous flush is in progress
+     return m_flushing;
+}
+
+void LCD::waitFlush()
+{
+     // Let the transport complete the spans of the asynchronous flush
+     while (m_flushing) {
+	  getTransport()->wait();
+     }
+}
+
+void LCD::setFlushCallback(void (*callback)())
+{
+     // Set the function called when an asynchronous flush completes
+     m_flushcallback = callback;
+}
+
+bool LCD::setDoubleBuffered(bool doubleBuffered, char *front)
+{
+     // Never change the front buffer while it is being sent
+     waitFlush();
+
+     // Free the front buffer if it was allocated here
+     if (m_ownfront) {
+	  free(m_front);
+     }
+
+     m_front = 0;
+     m_ownfront = false;
+
+     if (!doubleBuffered) {
+	  return true;
+     }
+
+     // Allocate the front buffer if none was given
+     if (!front) {
+	  front = (char *) malloc(BUFFER_SIZE);
+
+	  if (!front) {
+	       return false;
+	  }
+
+	  m_ownfront = true;
+     }
+
+     m_front = front;
+
+     return true;
+}
+
+bool LCD::isDoubleBuffered()
+{
+     // Return if the output has a front buffer
+     return m_front != 0;
+}
+
+bool LCD::setBuffered(bool buffered)
+{
+     if (!buffered && m_screen) {
+	  // Free the screen buffer if going from buffered to not buffered
+	  setBuffer(0);
      }
      else if (buffered && !m_screen) {
 	  // Initialize the screen buffer if going from not buffered to buffered
-	  m_screen = (char **) malloc(sizeof(char *) * 6);
+	  char *screen = (char *) malloc(BUFFER_SIZE);
 
-	  if (!m_screen) {
+	  if (!screen) {
 	       return false;
 	  }
 
-	  for (int i = 0; i < 6; i++) {
-	       m_screen[i] = (char *) malloc(sizeof(char) * 84);
+	  memset(screen, 0, BUFFER_SIZE);
 
-	       if (!m_screen[i]) {
-		    return false;
-	       }
+	  setBuffer(screen);
+	  m_ownscreen = true;
+     }
+
+     return true;
+}
+
+bool LCD::render(void (*draw)(), int rows, char *strip)
+{
+     // Never swap the screen buffer while it is being sent
+     waitFlush();
+
+     if (rows < 1 || rows > 6 || m_rendering) {
+	  return false;
+     }
+
+     // Allocate the strip buffer if none was given
+     bool allocated = false;
 
-	       memset(m_screen[i], 0, 84);
+     if (!strip) {
+	  strip = (char *) malloc(rows * 84);
+
+	  if (!strip) {
+	       return false;
 	  }
+
+	  allocated = true;
+     }
+
+     // Draw into the strip instead of the screen buffer, if any
+     char *screen = m_screen;
+     bool autoflush = m_autoflush;
+     int offset = m_rowOffset;
+
+     m_screen = strip;
+     m_autoflush = false;
+     m_rendering = true;
+     m_rowOffset = 0;
+
+     for (m_stripTop = 0; m_stripTop < 6; m_stripTop += rows) {
+	  // The last strip can have fewer rows
+	  m_stripRows = min(rows, 6 - m_stripTop);
+
+	  memset(strip, 0, m_stripRows * 84);
+
+	  draw();
+
+	  // Send the strip, its rows follow each other on the screen
+	  set(false, false, false);
+	  setCursor(0, m_stripTop);
+	  writeBytes(strip, m_stripRows * 84);
+     }
+
+     m_screen = screen;
+     m_autoflush = autoflush;
+     m_rendering = false;
+     m_rowOffset = offset;
+     m_stripTop = 0;
+     m_stripRows = 6;
+
+     if (allocated) {
+	  free(strip);
      }
 
+     // The screen no longer matches the screen buffer, if any
+     setDirty(m_screen != 0);
+
      return true;
 }
 
+bool LCD::isRendering()
+{
+     // Return if a render is in progress
+     return m_rendering;
+}
+
+int LCD::getStripTop()
+{
+     // Return the first screen row held by the strip
+     return m_stripTop;
+}
+
+int LCD::getStripRows()
+{
+     // Return the number of screen rows held by the strip
+     return m_stripRows;
+}
+
 bool LCD::isBuffered()
 {
      // Return if the output is being buffered
      return m_screen != 0;
 }
 
-void LCD::setFont(Font font)
+void LCD::setBuffer(char *buffer)
+{
+     // Free the screen buffer if it was allocated by setBuffered
+     waitFlush();
+
+     if (m_ownscreen) {
+	  free(m_screen);
+     }
+
+     m_screen = buffer;
+     m_ownscreen = false;
+     m_rowOffset = 0;
+
+     // The screen contents are unknown, so the whole buffer needs flushing
+     setDirty(true);
+}
+
+char *LCD::getBuffer()
+{
+     // Return the screen buffer, 0 if not buffered
+     return m_screen;
+}
+
+void LCD::scrollRows(int rows)
+{
+     LCD_STATS_RENDER();
+
+     // While rendering, the strip does not hold the rows scrolled in
+     if (!m_screen || m_rendering || rows == 0) {
+	  return;
+     }
+
+     // Scrolling by a screen or more clears it
+     if (rows >= 6 || rows <= -6) {
+	  rows = 6;
+     }
+
+     // Rotate the rows, the rows leaving at one end come back at the other
+     m_rowOffset = (m_rowOffset + rows + 6) % 6;
+
+     // Clear the rows coming in, at the bottom when scrolling up, at the top otherwise
+     for (int i = 0; i < abs(rows); i++) {
+	  memset(getRow(rows > 0 ? 5 - i : i), 0, 84);
+     }
+
+     // Every screen row shows different contents now
+     setDirty(true);
+
+     // Flush to the screen
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+int LCD::getRowOffset()
+{
+     return m_rowOffset;
+}
+
+void LCD::setFont(const Font &font)
 {
      // Set the font being used for output
      m_font = font;
@@ -177,45 +613,80 @@ Font LCD::getFont()
      return m_font;
 }
 
+void LCD::setGlyphCache(GlyphCache *cache)
+{
+     // Set the cache glyphs are read through
+     m_cache = cache;
+}
+
+GlyphCache *LCD::getGlyphCache()
+{
+     // Get the cache glyphs are read through
+     return m_cache;
+}
+
 void LCD::writeString(const char *string, int locx, int locy, int size, bool inverted)
 {
+     LCD_STATS_RENDER();
+
      // If not buffered, write direct
      if (!m_screen) {
 	  writeStringDirect(string, locx, locy / 8, inverted);
 	  return;
      }
 
-     int realSize = 1;
+     int realSize = getScale(size);
      int cxoff = 0;
      int cyoff = 0;
+     int rows = m_font.getRows();
+     char invert = inverted ? 0xFF : 0;
 
-     // Set the real size
-     for (int i = 0; i < size - 1; i++) {
-	  realSize *= 2;
-     }
-
-     // Set the addition amount after every character
-     int addition = realSize * m_font.getWidth();
+     // Only even sizes are smoothed, reading the columns around every column
+     bool smooth = m_scalestyle == SCALE_SMOOTH && realSize % 2 == 0;
 
      while (*string != 0) {
-	  // Loop through the columns of the character bitmap
-	  for (int col = 0; col < m_font.getWidth(); col++) {
-	       // Get the current column, and invert it if needed
-	       char column = m_font[(unsigned char) *string][col] ^ (inverted ? 0xFF : 0);
+	  // Get the width of the character, the same for every character unless the font is proportional
+	  int width = m_font.getCharWidth((unsigned char) *string);
 
-	       // Calculate the column x-offset
-	       int xoff = col * realSize;
+	  LCD_STATS_ADD(glyphs, 1);
 
-	       // Write the column to the buffer
-	       writeBuffered(column, locx, locy, cxoff + xoff, cyoff, realSize);
+	  // Get the whole character from the cache, if there is one
+	  const char *glyph = m_cache ? m_cache->getGlyph(m_font, (unsigned char) *string) : 0;
+
+	  // Loop through the screen rows the character spans, a row of its columns at a time
+	  // so the columns drawn in portrait go to the same block
+	  for (int row = 0; row < rows; row++) {
+	       // Loop through the columns of the character bitmap
+	       for (int col = 0; col < width; col++) {
+		    // Get the current column, and invert it if needed
+		    char column = (glyph ? glyph[(col * rows) + row] : m_font.getCharColumn((unsigned char) *string, col, row)) ^ invert;
+
+		    // Calculate the column x-offset
+		    int xoff = col * realSize;
+
+		    // Write the column to the buffer, smoothed with the columns around it in the character
+		    if (smooth) {
+			 unsigned char c = *string;
+
+			 writeSmoothed(m_font.getCharColumn(c, col - 1, row) ^ invert, column, m_font.getCharColumn(c, col + 1, row) ^ invert,
+				       m_font.getCharColumn(c, col, row - 1) ^ invert, m_font.getCharColumn(c, col, row + 1) ^ invert,
+				       locx + cxoff + xoff, locy + ((cyoff + (row * realSize)) * 8), realSize);
+		    }
+		    else {
+			 writeScaled(column, locx + cxoff + xoff, locy + ((cyoff + (row * realSize)) * 8), realSize);
+		    }
+	       }
 	  }
 
-	  // increment the character x-offset
-	  cxoff = cxoff + addition;
+	  // increment the character x-offset, by the width of the character and its kerning with the next one
+	  cxoff = cxoff + (realSize * (width + m_font.getKerning((unsigned char) string[0], (unsigned char) string[1])));
+
+	  // Set the addition amount of the next character
+	  int addition = realSize * m_font.getCharWidth((unsigned char) string[1]);
 
 	  // If there is a wrap style, apply the necessary corrections to the character x and y offsets
-	  if (m_wrapstyle != NO_WRAP && (cxoff + addition + locx) >= 84) {
-	       cyoff = cyoff + realSize;
+	  if (m_wrapstyle != NO_WRAP && (cxoff + addition + locx) >= getWidth()) {
+	       cyoff = cyoff + (realSize * rows);
 	       cxoff = 0;
 
 	       // If we are wrapping without new line, go back to beginning of the row
@@ -228,6 +699,8 @@ void LCD::writeString(const char *string, int locx, int locy, int size, bool inv
 	  string++;
      }
 
+     commitBlock();
+
      // Flush the screen buffer
      if (m_autoflush) {
 	  flush();
@@ -236,6 +709,11 @@ void LCD::writeString(const char *string, int locx, int locy, int size, bool inv
 
 void LCD::writeStringDirect(const char *string, int locx, int locy, bool inverted)
 {
+     LCD_STATS_TRANSFER();
+
+     // The screen rows spanned by the characters
+     int rows = m_font.getRows();
+
      // Set the screen settings for output
      set(false, false, false);
 
@@ -243,15 +721,24 @@ void LCD::writeStringDirect(const char *string, int locx, int locy, bool inverte
      locx = (locx & 0x7F) % 84;
      locy = (locy & 0x07) % 6;
 
-     // Set the cursor to the specified location
-     writeByte(0x80 + locx, COMMAND_BYTE); // X
-     writeByte(0x40 + locy, COMMAND_BYTE); // Y
+     // Whether the cursor has to be sent before the next character
+     bool moved = true;
 
      // Write the string to the LCD screen
      while (*string != 0) {
+	  // Get the width of the character, the same for every character unless the font is proportional
+	  int width = m_font.getCharWidth((unsigned char) *string);
+
+	  // Without wrapping, tall characters go on at the start of the next line of text, the way the
+	  // cursor of the LCD screen goes on at the start of the next screen row
+	  if (m_wrapstyle == NO_WRAP && rows > 1 && locx >= 84) {
+	       locx -= 84;
+	       locy = (locy + rows) % 6;
+	  }
+
 	  // Check if we need to wrap the text
-	  if (m_wrapstyle != NO_WRAP && locx + m_font.getWidth() >= 84) {
-	       locy++;
+	  if (m_wrapstyle != NO_WRAP && locx + width >= 84) {
+	       locy += rows;
 
 	       // If we are wrapping without new line, go back to beginning of the row
 	       if (m_wrapstyle == WRAP_RETURN) {
@@ -263,14 +750,45 @@ void LCD::writeStringDirect(const char *string, int locx, int locy, bool inverte
 		    break;
 	       }
 
-	       // Set the cursor to the specified location
-	       writeByte(0x80 + locx, COMMAND_BYTE); // X
-	       writeByte(0x40 + locy, COMMAND_BYTE); // Y
+	       moved = true;
+	  }
+
+	  LCD_STATS_ADD(glyphs, 1);
+
+	  // Get the whole character from the cache, if there is one
+	  const char *glyph = m_cache ? m_cache->getGlyph(m_font, (unsigned char) *string) : 0;
+
+	  // Write the bytes, a screen row at a time, the rows past the bottom of the screen are left out
+	  // A single row goes on where the previous character left the cursor of the LCD screen
+	  for (int row = 0; row < rows && locy + row < 6; row++) {
+	       if (moved || rows > 1) {
+		    setCursor(locx, locy + row);
+	       }
+
+	       // The screen no longer matches the buffer there, so it is sent on the next flush
+	       if (m_screen) {
+		    setDirty(locy + row, locx, locx + width - 1);
+	       }
+
+	       select(true);
+
+	       for (int i = 0; i < width; i++) {
+		    transfer((glyph ? glyph[(i * rows) + row] : m_font.getCharColumn((unsigned char) *string, i, row)) ^ (inverted ? 0xFF : 0));
+	       }
+
+	       getTransport()->deselect();
 	  }
 
-	  // Write the bytes
-	  for (int i = 0; i < m_font.getWidth(); i++, locx++) {
-	       writeByte(m_font[(unsigned char) *string][i] ^ (inverted ? 0xFF : 0), DATA_BYTE);
+	  locx += width;
+
+	  // Move the cursor by the kerning with the next character
+	  int kerning = m_font.getKerning((unsigned char) string[0], (unsigned char) string[1]);
+
+	  moved = false;
+
+	  if (kerning != 0 && locx + kerning >= 0 && locx + kerning < 84) {
+	       locx = locx + kerning;
+	       moved = true;
 	  }
 
 	  string++;
@@ -279,33 +797,43 @@ void LCD::writeStringDirect(const char *string, int locx, int locy, bool inverte
 
 void LCD::drawBitmap(char *bitmap, int locx, int locy, int width, int height, int scale, bool inverted)
 {
+     LCD_STATS_RENDER();
+
      // If not buffered, draw direct
      if (!m_screen) {
 	  drawBitmapDirect(bitmap, locx, locy / 8, width, height, inverted);
 	  return;
      }
 
-     int realScale = 1;
+     int realScale = getScale(scale);
+     char invert = inverted ? 0xFF : 0;
 
      // Set the correct height of the image in terms of LCD rows, not pixel rows
      height = ((height / 8) + ((height % 8) > 0 ? 1 : 0));
 
-     // Set the actual scale of the image
-     for (int i = 0; i < scale - 1; i++) {
-	  realScale *= 2;
-     }
+     // Only even scales are smoothed, reading the columns around every column
+     bool smooth = m_scalestyle == SCALE_SMOOTH && realScale % 2 == 0;
 
      // Loop through the bitmap rows
-     for (int y = 0; y < height && y < 6; y++) {
+     for (int y = 0; y < height && y < (getHeight() + 7) / 8; y++) {
 	  int curY = (y * width);
 
 	  // Loop through the bitmap columns
-	  for (int x = 0; x < width && x < (84 - locx); x++) {
-	       // Write the column to the buffer
-	       writeBuffered(bitmap[curY + x] ^ (inverted ? 0xFF : 0), locx, locy, x * realScale, y * realScale, realScale);
+	  for (int x = 0; x < width && x < (getWidth() - locx); x++) {
+	       // Write the column to the buffer, smoothed with the columns around it in the bitmap
+	       if (smooth) {
+		    writeSmoothed((x > 0 ? bitmap[curY + x - 1] : 0) ^ invert, bitmap[curY + x] ^ invert, (x + 1 < width ? bitmap[curY + x + 1] : 0) ^ invert,
+				  (y > 0 ? bitmap[curY + x - width] : 0) ^ invert, (y + 1 < height ? bitmap[curY + x + width] : 0) ^ invert,
+				  locx + (x * realScale), locy + (y * realScale * 8), realScale);
+	       }
+	       else {
+		    writeScaled(bitmap[curY + x] ^ invert, locx + (x * realScale), locy + (y * realScale * 8), realScale);
+	       }
 	  }
      }
 
+     commitBlock();
+
      // Flush the screen buffer
      if (m_autoflush) {
 	  flush();
@@ -314,6 +842,8 @@ void LCD::drawBitmap(char *bitmap, int locx, int locy, int width, int height, in
 
 void LCD::drawBitmapDirect(char *bitmap, int locx, int locy, int width, int height, bool inverted)
 {
+     LCD_STATS_TRANSFER();
+
      height = ((height / 8) + ((height % 8) > 0 ? 1 : 0));
 
      // Set the screen settings for output
@@ -323,192 +853,1378 @@ void LCD::drawBitmapDirect(char *bitmap, int locx, int locy, int width, int heig
      locx = (locx & 0x7F) % 84;
      locy = (locy & 0x07) % 6;
 
-     // Set the cursor to the specified location
-     writeByte(0x80 + locx, COMMAND_BYTE); // X
-     writeByte(0x40 + locy, COMMAND_BYTE); // Y
-
      for (int y = 0; y < height && y < (6 - locy); y++) {
 	  // Set next location
-	  writeByte(0x80 + locx, COMMAND_BYTE); // X
-	  writeByte(0x40 + (y + locy), COMMAND_BYTE); // Y
+	  setCursor(locx, y + locy);
 
 	  int curY = y * width;
 
+	  // The screen no longer matches the buffer there, so it is sent on the next flush
+	  if (m_screen) {
+	       setDirty(y + locy, locx, locx + width - 1);
+	  }
+
 	  // Draw 8 rows of pixels at a time
+	  select(true);
+
 	  for (int x = 0; x < width && x < (84 - locx); x++) {
-	       writeByte(bitmap[curY + x] ^ (inverted ? 0xFF : 0), DATA_BYTE);
+	       transfer(bitmap[curY + x] ^ (inverted ? 0xFF : 0));
 	  }
+
+	  getTransport()->deselect();
      }
 }
 
-void LCD::writeByte(char byte, byte_type type)
+void LCD::drawBitmapRLE(const char *bitmap, int locx, int locy, int scale, bool inverted)
 {
-     // Set the chip to look for clock cycles
-     digitalWrite(m_enable, LOW);
-     // Set the byte type
-     digitalWrite(m_type, (char) type);
+     LCD_STATS_RENDER();
 
-     // Write the byte to the LCD screen, one bit at a time, starting with high bit
-     for (int i = 0; i < 8; i++, byte <<= 1) {
-	  digitalWrite(m_clock, LOW);
-	  digitalWrite(m_output, byte < 0 ? HIGH : LOW);
-	  digitalWrite(m_clock, HIGH);
+     // If not buffered, draw direct
+     if (!m_screen) {
+	  drawBitmapRLEDirect(bitmap, locx, locy / 8, inverted);
+	  return;
      }
 
-     // Set the chip to ignore clock cycles
-     digitalWrite(m_enable, HIGH);
-}
+     RLEReader reader(bitmap);
+     int realScale = getScale(scale);
 
-void LCD::setAutoFlush(bool flush)
-{
-     // Set the autoflush tag
-     m_autoflush = flush;
-}
+     // Loop through the bitmap rows and columns, decoding every byte in order
+     for (int y = 0; y < reader.height; y++) {
+	  for (int x = 0; x < reader.width; x++) {
+	       char column = reader.next() ^ (inverted ? 0xFF : 0);
 
-bool LCD::isAutoFlush()
-{
+	       // Write the column to the buffer
+	       writeScaled(column, locx + (x * realScale), locy + (y * realScale * 8), realScale);
+	  }
+     }
+
+     commitBlock();
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawBitmapRLEDirect(const char *bitmap, int locx, int locy, bool inverted)
+{
+     LCD_STATS_TRANSFER();
+
+     RLEReader reader(bitmap);
+
+     // Set the screen settings for output
+     set(false, false, false);
+
+     // Make sure the values are within limits
+     locx = (locx & 0x7F) % 84;
+     locy = (locy & 0x07) % 6;
+
+     for (int y = 0; y < reader.height && y < (6 - locy); y++) {
+	  // Set next location
+	  setCursor(locx, y + locy);
+
+	  // The screen no longer matches the buffer there, so it is sent on the next flush
+	  if (m_screen) {
+	       setDirty(y + locy, locx, locx + reader.width - 1);
+	  }
+
+	  // Draw 8 rows of pixels at a time, decoding the columns past the screen edge without sending them
+	  select(true);
+
+	  for (int x = 0; x < reader.width; x++) {
+	       char column = reader.next() ^ (inverted ? 0xFF : 0);
+
+	       if (x < (84 - locx)) {
+		    transfer(column);
+	       }
+	  }
+
+	  getTransport()->deselect();
+     }
+}
+
+void LCD::drawPixel(int x, int y, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen) {
+	  return;
+     }
+
+     fillSpan(x, y, x, y, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawHLine(int x, int y, int width, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen || width <= 0) {
+	  return;
+     }
+
+     fillSpan(x, y, x + width - 1, y, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawVLine(int x, int y, int height, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen || height <= 0) {
+	  return;
+     }
+
+     fillSpan(x, y, x, y + height - 1, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawLine(int x0, int y0, int x1, int y1, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen) {
+	  return;
+     }
+
+     // Bresenham's line algorithm, stepping x, y or both towards the end of the line
+     int dx = abs(x1 - x0);
+     int dy = -abs(y1 - y0);
+     int sx = x0 < x1 ? 1 : -1;
+     int sy = y0 < y1 ? 1 : -1;
+     int err = dx + dy;
+
+     // The pixels are drawn in straight runs, from (runx, runy) to (x0, y0)
+     int runx = x0;
+     int runy = y0;
+
+     while (true) {
+	  bool end = x0 == x1 && y0 == y1;
+	  int nx = x0;
+	  int ny = y0;
+
+	  if (!end) {
+	       int e2 = 2 * err;
+
+	       if (e2 >= dy) {
+		    err += dy;
+		    nx += sx;
+	       }
+
+	       if (e2 <= dx) {
+		    err += dx;
+		    ny += sy;
+	       }
+	  }
+
+	  // Draw the run when the next pixel is not in line with it
+	  if (end || !((ny == y0 && y0 == runy) || (nx == x0 && x0 == runx))) {
+	       fillSpan(min(runx, x0), min(runy, y0), max(runx, x0), max(runy, y0), on);
+
+	       runx = nx;
+	       runy = ny;
+	  }
+
+	  if (end) {
+	       break;
+	  }
+
+	  x0 = nx;
+	  y0 = ny;
+     }
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawRect(int x, int y, int width, int height, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen || width <= 0 || height <= 0) {
+	  return;
+     }
+
+     // Top and bottom sides, then left and right ones between them
+     fillSpan(x, y, x + width - 1, y, on);
+     fillSpan(x, y + height - 1, x + width - 1, y + height - 1, on);
+     fillSpan(x, y + 1, x, y + height - 2, on);
+     fillSpan(x + width - 1, y + 1, x + width - 1, y + height - 2, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::fillRect(int x, int y, int width, int height, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen || width <= 0 || height <= 0) {
+	  return;
+     }
+
+     fillSpan(x, y, x + width - 1, y + height - 1, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawCircle(int x, int y, int radius, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen || radius < 0) {
+	  return;
+     }
+
+     // The quarter circles all have the same center
+     drawArcs(x, y, x, y, radius, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawRoundRect(int x, int y, int width, int height, int radius, bool on)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen || width <= 0 || height <= 0) {
+	  return;
+     }
+
+     // The corners can take at most half of each side
+     radius = min(radius, (min(width, height) - 1) / 2);
+
+     if (radius < 0) {
+	  radius = 0;
+     }
+
+     // The centers of the corners
+     int x0 = x + radius;
+     int y0 = y + radius;
+     int x1 = x + width - 1 - radius;
+     int y1 = y + height - 1 - radius;
+
+     // The straight sides between the corners
+     fillSpan(x0, y, x1, y, on);
+     fillSpan(x0, y + height - 1, x1, y + height - 1, on);
+     fillSpan(x, y0, x, y1, on);
+     fillSpan(x + width - 1, y0, x + width - 1, y1, on);
+
+     drawArcs(x0, y0, x1, y1, radius, on);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawSprite(Sprite &sprite, int x, int y, Sprite::raster_op op)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to
+     if (!m_screen) {
+	  return;
+     }
+
+     int shift = y & 7;
+     int top = y >> 3;
+
+     // A shifted sprite covers one more screen row
+     int rows = sprite.getRows() + (shift ? 1 : 0);
+
+     // Clip the columns to the screen
+     int first = max(x, 0);
+     int last = min(x + sprite.getWidth() - 1, 83);
+
+     if (first > last) {
+	  return;
+     }
+
+     for (int i = 0; i < rows; i++) {
+	  int row = top + i;
+	  char *screen = getRow(row);
+
+	  if (!screen) {
+	       continue;
+	  }
+
+	  for (int sx = first; sx <= last; sx++) {
+	       unsigned char bits;
+	       unsigned char mask;
+
+	       sprite.getColumn(sx - x, i, shift, bits, mask);
+
+	       // Clear the pixels under the mask, then combine the sprite
+	       unsigned char byte = screen[sx] & ~mask;
+
+	       switch (op) {
+	       case Sprite::OP_AND_NOT:
+		    byte &= ~bits;
+		    break;
+	       case Sprite::OP_XOR:
+		    byte ^= bits;
+		    break;
+	       default:
+		    byte |= bits;
+		    break;
+	       }
+
+	       screen[sx] = byte;
+	  }
+
+	  setDirty(row, first, last);
+     }
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::drawTile(const char *tile, int column, int row)
+{
+     LCD_STATS_RENDER();
+
+     // Only the screen buffer can be drawn to, in whole tiles
+     if (!m_screen || column < 0 || column > 10 || !getRow(row)) {
+	  return;
+     }
+
+     // The last column of tiles is cut by the edge of the screen
+     int x = column * 8;
+     int width = min(8, 84 - x);
+
+     if (tile) {
+	  memcpy_P(getRow(row) + x, tile, width);
+     }
+     else {
+	  memset(getRow(row) + x, 0, width);
+     }
+
+     setDirty(row, x, x + width - 1);
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::scroll(int dx, int dy)
+{
+     scroll(dx, dy, 0, 0, 84, 48);
+}
+
+void LCD::scroll(int dx, int dy, int x, int y, int width, int height)
+{
+     LCD_STATS_RENDER();
+
+     // Clip the window to the screen, in landscape
+     int x0 = max(x, 0);
+     int y0 = max(y, 0);
+     int x1 = min(x + width - 1, 83);
+     int y1 = min(y + height - 1, 47);
+
+     // While rendering, the strip does not hold the pixels scrolled in
+     if (!m_screen || m_rendering || x0 > x1 || y0 > y1 || (dx == 0 && dy == 0)) {
+	  return;
+     }
+
+     // The screen rows of the window, and the pixels of the window in each of them
+     int row0 = y0 / 8;
+     int row1 = y1 / 8;
+     unsigned char masks[6];
+
+     for (int row = row0; row <= row1; row++) {
+	  unsigned char mask = 0xFF;
+
+	  if (row == row0) {
+	       mask &= 0xFF << (y0 % 8);
+	  }
+
+	  if (row == row1) {
+	       mask &= 0xFF >> (7 - (y1 % 8));
+	  }
+
+	  masks[row] = mask;
+     }
+
+     // Scroll horizontally, a screen row at a time
+     if (dx != 0) {
+	  for (int row = row0; row <= row1; row++) {
+	       scrollColumns(dx, x0, x1, row, masks[row]);
+	  }
+     }
+
+     // Scroll vertically, a column at a time
+     if (dy != 0) {
+	  for (int column = x0; column <= x1; column++) {
+	       shiftColumn(dy, column, row0, row1, masks);
+	  }
+     }
+
+     for (int row = row0; row <= row1; row++) {
+	  setDirty(row, x0, x1);
+     }
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
+void LCD::writeByte(char byte, byte_type type)
+{
+     LCD_STATS_TRANSFER();
+
+     // Send the byte through the transport
+     select(type == DATA_BYTE);
+     transfer(byte);
+     getTransport()->deselect();
+
+     // A command may change the controller in ways not followed here
+     if (type == COMMAND_BYTE) {
+	  forgetState();
+     }
+}
+
+void LCD::writeBytes(const char *bytes, int count, byte_type type)
+{
+     LCD_STATS_TRANSFER();
+
+     // Send all the bytes with the chip enabled once
+     select(type == DATA_BYTE);
+
+     for (int i = 0; i < count; i++) {
+	  transfer(bytes[i]);
+     }
+
+     getTransport()->deselect();
+
+     // Commands may change the controller in ways not followed here
+     if (type == COMMAND_BYTE) {
+	  forgetState();
+     }
+}
+
+void LCD::writeBytes_P(const char *bytes, int count, byte_type type)
+{
+     LCD_STATS_TRANSFER();
+
+     // Send all the bytes with the chip enabled once, reading them from program memory
+     select(type == DATA_BYTE);
+
+     for (int i = 0; i < count; i++) {
+	  transfer(pgm_read_byte(bytes + i));
+     }
+
+     getTransport()->deselect();
+
+     // Commands may change the controller in ways not followed here
+     if (type == COMMAND_BYTE) {
+	  forgetState();
+     }
+}
+
+void LCD::setAutoFlush(bool flush)
+{
+     // Set the autoflush tag
+     m_autoflush = flush;
+}
+
+bool LCD::isAutoFlush()
+{
      // Return the autoflush flag
      return m_autoflush;
 }
 
-void LCD::setWrapStyle(wrap_style wrap)
+void LCD::setWrapStyle(wrap_style wrap)
+{
+     // Set the wrap style
+     m_wrapstyle = wrap;
+}
+
+LCD::wrap_style LCD::getWrapStyle()
+{
+     // Return the wrap style
+     return m_wrapstyle;
+}
+
+void LCD::setScaleStyle(scale_style style)
+{
+     // Set the scale style
+     m_scalestyle = style;
+}
+
+LCD::scale_style LCD::getScaleStyle()
+{
+     // Return the scale style
+     return m_scalestyle;
+}
+
+void LCD::setOrientation(orientation o)
+{
+     // Set the orientation of the buffered drawing functions
+     m_orientation = o;
+}
+
+LCD::orientation LCD::getOrientation()
+{
+     // Return the orientation
+     return m_orientation;
+}
+
+int LCD::getWidth()
+{
+     // Portrait orientations are odd
+     return (m_orientation & 1) ? 48 : 84;
+}
+
+int LCD::getHeight()
+{
+     // Portrait orientations are odd
+     return (m_orientation & 1) ? 84 : 48;
+}
+
+void LCD::setPowerDown(bool power_down)
+{
+     LCD_STATS_TRANSFER();
+
+     // Set the LCD screen power down state
+     set(power_down, false, false);
+}
+
+void LCD::setBacklight(bool bs)
+{
+     // Set the LCD screen backlight state
+     digitalWrite(m_backlight, bs ? HIGH : LOW);
+}
+
+void LCD::setBiasSystem(bias_system bs)
+{
+     LCD_STATS_TRANSFER();
+
+     // Set the LCD screen bias voltage, with the extended function set
+     writeCommand(0x10 + bs, true);
+}
+
+void LCD::setTemperatureControl(temperature_control tc)
+{
+     LCD_STATS_TRANSFER();
+
+     // Set the LCD screen temperature control coefficient, with the extended function set
+     writeCommand(0x04 + tc, true);
+}
+
+void LCD::setOperatingVoltage(char vop)
+{
+     LCD_STATS_TRANSFER();
+
+     // Set the LCD screen operating voltage, only the last 6 bits of the char,
+     // with the extended function set
+     writeCommand(0x80 + (vop & 0x7F), true);
+}
+
+void LCD::setDisplayMode(display_mode mode)
+{
+     LCD_STATS_TRANSFER();
+
+     // Set the LCD screen display mode, with the normal function set
+     writeCommand(0x08 + mode, false);
+}
+
+#ifdef LCD_STATS
+LCD::Stats LCD::getStats()
+{
+     // Return a copy of the counters
+     return m_stats;
+}
+
+void LCD::resetStats()
+{
+     // Set all the counters to 0
+     memset(&m_stats, 0, sizeof(m_stats));
+}
+#endif
+
+// Private functions below
+
+void LCD::set(bool power_down, bool vertical, bool extended)
+{
+     // Set the LCD screen settings
+     char data = 0x20 + (power_down ? 4 : 0) + (vertical ? 2 : 0) + (extended ? 1 : 0);
+
+     // Never read the state of the controller while a flush is changing it
+     waitFlush();
+
+     // Leave the command out if the controller already has these settings
+     if (m_function == data) {
+	  return;
+     }
+
+     sendCommands(&data, 1);
+
+     m_function = data;
+}
+
+void LCD::setCursor(int x, int y)
+{
+     char data[2];
+     int count = 0;
+
+     // Never read the state of the controller while a flush is changing it
+     waitFlush();
+
+     // Only send the addresses the address counter does not have already,
+     // both commands in a single transfer
+     if (m_cursorX != x) {
+	  data[count++] = 0x80 + x;
+     }
+
+     if (m_cursorY != y) {
+	  data[count++] = 0x40 + y;
+     }
+
+     if (count > 0) {
+	  sendCommands(data, count);
+     }
+
+     m_cursorX = x;
+     m_cursorY = y;
+
+     // Addresses past the end of the screen leave the address counter unknown
+     if (x > 83 || y > 5) {
+	  m_cursorX = -1;
+	  m_cursorY = -1;
+     }
+}
+
+void LCD::writeGlyph(const char *glyph, int width, int rows, int x, int y, int scale, bool inverted)
 {
-     // Set the wrap style
-     m_wrapstyle = wrap;
+     LCD_STATS_ADD(glyphs, 1);
+     LCD_STATS_RENDER();
+
+     char invert = inverted ? 0xFF : 0;
+
+     // Only even scales are smoothed, reading the columns around every column
+     bool smooth = m_scalestyle == SCALE_SMOOTH && scale % 2 == 0 && glyph;
+
+     // Loop through the screen rows the character spans, then its columns, blank if not in the font
+     for (int row = 0; row < rows; row++) {
+	  for (int col = 0; col < width; col++) {
+	       char column = (glyph ? pgm_read_byte(glyph + (col * rows) + row) : 0) ^ invert;
+
+	       if (smooth) {
+		    writeSmoothed((col > 0 ? pgm_read_byte(glyph + ((col - 1) * rows) + row) : 0) ^ invert, column,
+				  (col + 1 < width ? pgm_read_byte(glyph + ((col + 1) * rows) + row) : 0) ^ invert,
+				  (row > 0 ? pgm_read_byte(glyph + (col * rows) + row - 1) : 0) ^ invert,
+				  (row + 1 < rows ? pgm_read_byte(glyph + (col * rows) + row + 1) : 0) ^ invert,
+				  x + (col * scale), y + (row * 8 * scale), scale);
+	       }
+	       else {
+		    writeScaled(column, x + (col * scale), y + (row * 8 * scale), scale);
+	       }
+	  }
+     }
 }
 
-LCD::wrap_style LCD::getWrapStyle()
+int LCD::getScale(int size)
 {
-     // Return the wrap style
-     return m_wrapstyle;
+     // Sizes below 1 are not scaled
+     if (size < 1) {
+	  return 1;
+     }
+
+     return m_scalestyle == SCALE_POWER ? 1 << (size - 1) : size;
 }
 
-void LCD::setPowerDown(bool power_down)
+void LCD::writeScaled(char column, int x, int y, int scale)
 {
-     // Set the LCD screen power down state
-     set(power_down, false, false);
+     unsigned char expanded[8];
+
+     // Unscaled columns are copied straight into the buffer
+     if (scale == 1) {
+	  writeColumn(column, x, y);
+	  return;
+     }
+
+     // A scaled column starting left of the screen is left out whole
+     if (x < 0 || x >= getWidth()) {
+	  return;
+     }
+
+     // Expand the column into scale bytes, each written scale times side by side
+     if (!expandColumn(column, scale, expanded)) {
+	  return;
+     }
+
+     for (int i = 0; i < scale; i++) {
+	  for (int j = 0; j < scale && x + j < getWidth(); j++) {
+	       writeColumn(expanded[i], x + j, y + (i * 8));
+	  }
+     }
 }
 
-void LCD::setBacklight(bool bs)
+void LCD::writeSmoothed(char left, char column, char right, char above, char below, int x, int y, int scale)
 {
-     // Set the LCD screen backlight state
-     digitalWrite(m_backlight, bs ? HIGH : LOW);
+     // Odd scales are not smoothed
+     if (scale % 2 != 0) {
+	  writeScaled(column, x, y, scale);
+	  return;
+     }
+
+     // The neighbors of every pixel of the column, the pixels above and below coming
+     // from the next pixel of the column, or from the screen rows above and below it
+     unsigned char pixels = column;
+     unsigned char l = left;
+     unsigned char r = right;
+     unsigned char u = (pixels << 1) | ((unsigned char) above >> 7);
+     unsigned char d = (pixels >> 1) | ((unsigned char) below << 7);
+
+     // The four corners of every pixel scaled by 2
+     unsigned char topLeft = smoothCorner(pixels, l, u, r, d);
+     unsigned char topRight = smoothCorner(pixels, u, r, d, l);
+     unsigned char bottomLeft = smoothCorner(pixels, d, l, u, r);
+     unsigned char bottomRight = smoothCorner(pixels, r, d, l, u);
+
+     // The two columns scaled by 2, each of two bytes, then scaled by the rest of the scale
+     unsigned char smoothed[2][2] = {
+	  { interleave(topLeft, bottomLeft), interleave(topLeft >> 4, bottomLeft >> 4) },
+	  { interleave(topRight, bottomRight), interleave(topRight >> 4, bottomRight >> 4) }
+     };
+
+     int factor = scale / 2;
+     unsigned char expanded[8];
+
+     for (int half = 0; half < 2; half++) {
+	  for (int i = 0; i < 2; i++) {
+	       if (!expandColumn(smoothed[half][i], factor, expanded)) {
+		    return;
+	       }
+
+	       for (int k = 0; k < factor; k++) {
+		    for (int j = 0; j < factor; j++) {
+			 int cx = x + (half * factor) + j;
+
+			 if (cx >= 0 && cx < getWidth()) {
+			      writeColumn(expanded[k], cx, y + (((i * factor) + k) * 8));
+			 }
+		    }
+	       }
+	  }
+     }
 }
 
-void LCD::setBiasSystem(bias_system bs)
+void LCD::writeColumn(char column, int x, int y)
 {
-     // Set the LCD screen bias voltage
-     char byte = 0x10 + bs;
+     switch (m_orientation) {
+     case LANDSCAPE:
+	  writeMasked(column, 0xFF, x, y);
+	  return;
+     case REV_LANDSCAPE:
+	  // Upside down, the column is mirrored both ways
+	  writeMasked(reverseBits(column), 0xFF, 83 - x, 40 - y);
+	  return;
+     default:
+	  break;
+     }
 
-     // Set extended function set
-     set(false, false, true);
+     // Clip the column to the portrait screen
+     if (x < 0 || x >= 48 || y <= -8 || y >= 84) {
+	  return;
+     }
+
+     // Start a new block if the column is not part of the current one
+     if (m_blockColumns && ((x & ~7) != m_blockX || y != m_blockY)) {
+	  commitBlock();
+     }
 
-     writeByte(byte, COMMAND_BYTE);
+     m_blockX = x & ~7;
+     m_blockY = y;
+     m_block[x & 7] = column;
+     m_blockColumns |= 1 << (x & 7);
 }
 
-void LCD::setTemperatureControl(temperature_control tc)
+void LCD::commitBlock()
 {
-     // Set the LCD screen temperature control coefficient
-     char byte = 0x04 + tc;
+     if (!m_blockColumns) {
+	  return;
+     }
+
+     // Row j of the block becomes column j, which is a landscape column once rotated
+     transpose((unsigned char *) m_block);
 
-     // Set extended function set
-     set(false, false, true);
+     for (int j = 0; j < 8; j++) {
+	  if (m_orientation == PORTRAIT) {
+	       // The top of the block is on the right of the landscape screen
+	       writeMasked(m_block[j], m_blockColumns, 83 - (m_blockY + j), m_blockX);
+	  }
+	  else {
+	       // The top of the block is on the left of the landscape screen, its left at the bottom
+	       writeMasked(reverseBits(m_block[j]), reverseBits(m_blockColumns), m_blockY + j, 40 - m_blockX);
+	  }
+     }
 
-     writeByte(byte, COMMAND_BYTE);
+     m_blockColumns = 0;
 }
 
-void LCD::setOperatingVoltage(char vop)
+void LCD::writeMasked(char column, char mask, int x, int y)
 {
-     // Set the LCD screen operating voltage, only the last 6 bits of the char
-     char byte = 0x80 + (vop & 0x7F);
+     // Clip the column to the screen
+     if (x < 0 || x >= 84 || y <= -8 || y >= 48) {
+	  return;
+     }
+
+     unsigned char bits = column & mask;
+     unsigned char select = mask;
+     int row = y >> 3;
+     int shift = y & 7;
+     char *screen = getRow(row);
+     char *below = getRow(row + 1);
+
+     // A column aligned to a screen row replaces the masked bits of a byte
+     if (shift == 0) {
+	  if (screen) {
+	       screen[x] = (screen[x] & ~select) | bits;
+	       setDirty(row, x, x);
+	  }
 
-     // Set extended function set
-     set(false, false, true);
+	  return;
+     }
+
+     // Otherwise its top part goes to the high bits of the row, and the rest to the next row
+     if (screen) {
+	  screen[x] = (screen[x] & ~(select << shift)) | (bits << shift);
+	  setDirty(row, x, x);
+     }
 
-     writeByte(byte, COMMAND_BYTE);
+     if (below) {
+	  below[x] = (below[x] & ~(select >> (8 - shift))) | (bits >> (8 - shift));
+	  setDirty(row + 1, x, x);
+     }
 }
 
-void LCD::setDisplayMode(display_mode mode)
+char *LCD::getRow(int row)
 {
-     // Set the LCD screen display mode
-     char byte = 0x08 + mode;
-
-     // Set normal function set
-     set(false, false, false);
+     // Only the rows of the strip being rendered are in the buffer, all of them otherwise
+     if (row < m_stripTop || row >= m_stripTop + m_stripRows) {
+	  return 0;
+     }
 
-     writeByte(byte, COMMAND_BYTE);
+     return m_screen + ((((row + m_rowOffset) % 6) - m_stripTop) * 84);
 }
 
-// Private functions below
+void LCD::fillSpan(int x0, int y0, int x1, int y1, bool on)
+{
+     // Clip the rectangle to the screen, in the current orientation
+     x0 = max(x0, 0);
+     y0 = max(y0, 0);
+     x1 = min(x1, getWidth() - 1);
+     y1 = min(y1, getHeight() - 1);
 
-void LCD::set(bool power_down, bool vertical, bool extended)
+     if (x0 > x1 || y0 > y1) {
+	  return;
+     }
+
+     // A rectangle rotates into a rectangle, only its corners need mapping
+     int left;
+     int top;
+     int right;
+     int bottom;
+
+     switch (m_orientation) {
+     case PORTRAIT:
+	  left = 83 - y1;
+	  right = 83 - y0;
+	  top = x0;
+	  bottom = x1;
+	  break;
+     case REV_LANDSCAPE:
+	  left = 83 - x1;
+	  right = 83 - x0;
+	  top = 47 - y1;
+	  bottom = 47 - y0;
+	  break;
+     case REV_PORTRAIT:
+	  left = y0;
+	  right = y1;
+	  top = 47 - x1;
+	  bottom = 47 - x0;
+	  break;
+     default:
+	  left = x0;
+	  right = x1;
+	  top = y0;
+	  bottom = y1;
+	  break;
+     }
+
+     // Write the span a screen row at a time, as a mask of the rows of pixels it covers
+     for (int row = top >> 3; row <= bottom >> 3; row++) {
+	  unsigned char mask = 0xFF;
+	  char *screen = getRow(row);
+
+	  if (!screen) {
+	       continue;
+	  }
+
+	  if (row == top >> 3) {
+	       mask &= 0xFF << (top & 7);
+	  }
+
+	  if (row == bottom >> 3) {
+	       mask &= 0xFF >> (7 - (bottom & 7));
+	  }
+
+	  if (on) {
+	       for (int x = left; x <= right; x++) {
+		    screen[x] |= mask;
+	       }
+	  }
+	  else {
+	       for (int x = left; x <= right; x++) {
+		    screen[x] &= ~mask;
+	       }
+	  }
+
+	  setDirty(row, left, right);
+     }
+}
+
+void LCD::scrollColumns(int dx, int x0, int x1, int row, unsigned char mask)
 {
-     // Set the LCD screen settings
-     char data = 0x20 + (power_down ? 4 : 0) + (vertical ? 2 : 0) + (extended ? 1 : 0);
+     char *screen = getRow(row);
+     int count = x1 - x0 + 1 - abs(dx);
+
+     // Everything scrolls out of the window
+     if (count <= 0) {
+	  for (int x = x0; x <= x1; x++) {
+	       screen[x] &= ~mask;
+	  }
+
+	  return;
+     }
+
+     // The columns staying in the window, and the columns coming in
+     int from = dx > 0 ? x0 : x0 - dx;
+     int to = dx > 0 ? x0 + dx : x0;
+     int first = dx > 0 ? x0 : x1 + dx + 1;
+
+     // A whole screen row is moved as a block
+     if (mask == 0xFF) {
+	  memmove(screen + to, screen + from, count);
+	  memset(screen + first, 0, abs(dx));
+	  return;
+     }
+
+     // Otherwise only the pixels of the window are moved, from the end the columns move to
+     if (dx > 0) {
+	  for (int i = count - 1; i >= 0; i--) {
+	       screen[to + i] = (screen[to + i] & ~mask) | (screen[from + i] & mask);
+	  }
+     }
+     else {
+	  for (int i = 0; i < count; i++) {
+	       screen[to + i] = (screen[to + i] & ~mask) | (screen[from + i] & mask);
+	  }
+     }
 
-     writeByte(data, COMMAND_BYTE);
+     for (int x = first; x < first + abs(dx); x++) {
+	  screen[x] &= ~mask;
+     }
 }
 
-void LCD::writeBuffered(char column, int locx, int locy, int cxoff, int cyoff, int size)
+void LCD::shiftColumn(int dy, int x, int row0, int row1, const unsigned char *masks)
 {
-     int divisor = 8 / size;
+     unsigned char bits[6];
+     int rows = abs(dy) / 8;
+     int shift = abs(dy) % 8;
+     unsigned char carry = 0;
+
+     // Move whole bytes first, taking only the pixels of the window
+     for (int row = row0; row <= row1; row++) {
+	  int source = dy > 0 ? row - rows : row + rows;
+
+	  bits[row] = (source >= row0 && source <= row1) ? getRow(source)[x] & masks[source] : 0;
+     }
 
-     // Loop through the bits in the bitmap column
-     for (int row = 7; row >= 0; row--) {
-	  // Calculate the y-offset, and the shift amount for the current bit
-	  int yoff = (row / divisor) + (locy / 8);
-	  int shift = ((row % divisor) * size) + (locy % 8);
-	  char dot = 1 << shift;
+     // Then shift the bits down, or up, carrying the bits leaving a screen row into the next one
+     if (shift > 0) {
+	  if (dy > 0) {
+	       for (int row = row0; row <= row1; row++) {
+		    unsigned char next = bits[row] >> (8 - shift);
 
-	  // If the shift amount is negative due to locy being negative, set dot to 0
-	  if (shift < 0) {
-	       dot = 0;
+		    bits[row] = (bits[row] << shift) | carry;
+		    carry = next;
+	       }
 	  }
+	  else {
+	       for (int row = row1; row >= row0; row--) {
+		    unsigned char next = bits[row] << (8 - shift);
 
-	  // Loop through a realSize * realSize square for a character pixel
-	  for (int y = 0; y < size; y++) {
-	       // If the shift amount was negative, do correction for offset character pixels
-	       if (dot == 0 && shift < 8) {
-		    if (y == 0) {
-			 dot = 0x80 >> (abs(shift) - 1);
-			 yoff = yoff - 1;
-		    }
-		    else {
-			 dot = 1;
-			 yoff = yoff + 1;
-		    }
+		    bits[row] = (bits[row] >> shift) | carry;
+		    carry = next;
 	       }
+	  }
+     }
 
-	       // Loop through the current row of the characyer pixel
-	       for (int x = 0; x < size; x++) {
-		    // If there was over-shift, apply the correction
-		    if (dot == 0 && shift >= 8) {
-			 dot = 1 << (shift - 8);
-			 yoff = yoff + 1;
-		    }
+     // Put the pixels back in the window, the ones shifted out of it are dropped
+     for (int row = row0; row <= row1; row++) {
+	  char *screen = getRow(row);
 
-		    // Check if we are out of bounds after correction
-		    int rx = cxoff + x + locx;
-		    int ry = cyoff + yoff;
+	  screen[x] = (screen[x] & ~masks[row]) | (bits[row] & masks[row]);
+     }
+}
 
-		    if (rx < 0 || rx >= 84 || ry < 0 || ry >= 6) {
-			 break;
-		    }
+void LCD::drawArcs(int x0, int y0, int x1, int y1, int r, bool on)
+{
+     // Midpoint circle algorithm over the octant from the top (0, r) to the diagonal
+     int x = 0;
+     int y = r;
+     int d = 1 - r;
 
-		    // Draw screen pixel (rx, ry) of the character pixel
-		    if (column < 0) {
-			 m_screen[ry][rx] |= dot;
-		    }
-		    else {
-			 m_screen[ry][rx] &= ~dot;
-		    }
+     // The points of the octant from (start, y) to (x, y) are on the same row, drawn as
+     // a horizontal span near the top and bottom, and a vertical span near the sides
+     int start = 0;
+
+     while (x <= y) {
+	  int nx = x + 1;
+	  int ny = y;
+
+	  if (d < 0) {
+	       d += (2 * nx) + 1;
+	  }
+	  else {
+	       ny--;
+	       d += (2 * (nx - ny)) + 1;
+	  }
+
+	  // Draw the run in all 8 octants when the next point leaves the row
+	  if (ny != y || nx > ny) {
+	       fillSpan(x1 + start, y0 - y, x1 + x, y0 - y, on);
+	       fillSpan(x0 - x, y0 - y, x0 - start, y0 - y, on);
+	       fillSpan(x1 + start, y1 + y, x1 + x, y1 + y, on);
+	       fillSpan(x0 - x, y1 + y, x0 - start, y1 + y, on);
+
+	       fillSpan(x1 + y, y0 - x, x1 + y, y0 - start, on);
+	       fillSpan(x0 - y, y0 - x, x0 - y, y0 - start, on);
+	       fillSpan(x1 + y, y1 + start, x1 + y, y1 + x, on);
+	       fillSpan(x0 - y, y1 + start, x0 - y, y1 + x, on);
+
+	       start = nx;
+	  }
+
+	  x = nx;
+	  y = ny;
+     }
+}
+
+void LCD::setDirty(int ry, int first, int last)
+{
+     // Columns past the end of the row continue on the next one, like the cursor of the LCD screen
+     if (last > 83) {
+	  setDirty(ry + 1, first - 84, last - 84);
+	  last = 83;
+     }
+
+     // Clip the span to the screen row
+     if (first < 0) {
+	  first = 0;
+     }
+
+     if (ry < 0 || ry >= 6 || first > last) {
+	  return;
+     }
+
+     // Grow the dirty span of the row to include the new columns
+     if (first < m_dirtyFirst[ry]) {
+	  m_dirtyFirst[ry] = first;
+     }
+
+     if (last > m_dirtyLast[ry]) {
+	  m_dirtyLast[ry] = last;
+     }
+}
+
+void LCD::setDirty(bool dirty)
+{
+     // A clean row has its first dirty column past its last one
+     for (int i = 0; i < 6; i++) {
+	  m_dirtyFirst[i] = dirty ? 0 : 83;
+	  m_dirtyLast[i] = dirty ? 83 : 0;
+     }
+}
+
+void LCD::setDefaults()
+{
+     // Initialize the members shared by all constructors
+     m_screen = 0;
+     m_ownscreen = false;
+     m_front = 0;
+     m_ownfront = false;
+     m_flushing = false;
+     m_flushcallback = 0;
+     m_autoflush = true;
+     m_wrapstyle = WRAP_RETURN;
+     m_scalestyle = SCALE_POWER;
+     m_orientation = LANDSCAPE;
+     m_blockColumns = 0;
+     m_stripTop = 0;
+     m_stripRows = 6;
+     m_rendering = false;
+     m_rowOffset = 0;
+
+     m_selectedData = false;
+     forgetState();
+
+#ifdef LCD_STATS
+     m_statsRender = false;
+     m_statsTransfer = false;
+     resetStats();
+#endif
+     m_font = Font();
+     m_cache = 0;
+
+     setDirty(false);
+}
+
+Transport *LCD::getTransport()
+{
+     // Copies of an instance made with the pin constructor use their own bit-bang transport
+     return m_transport ? m_transport : &m_bitbang;
+}
+
+void LCD::select(bool data)
+{
+     // Wait for an asynchronous flush, then enable the chip
+     waitFlush();
+
+     m_selectedData = data;
+
+     getTransport()->select(data);
+}
+
+void LCD::transfer(char byte)
+{
+#ifdef LCD_STATS
+     if (m_selectedData) {
+	  m_stats.dataBytes++;
+     }
+     else {
+	  m_stats.commandBytes++;
+     }
+#endif
+
+     // Data bytes move the address counter of the controller to the next column
+     if (m_selectedData && m_cursorX >= 0) {
+	  if (++m_cursorX > 83) {
+	       m_cursorX = 0;
+
+	       if (++m_cursorY > 5) {
+		    m_cursorY = 0;
 	       }
+	  }
+     }
+
+     getTransport()->transfer(byte);
+}
+
+void LCD::sendCommands(const char *commands, int count)
+{
+     // Send all the commands with the chip enabled once
+     select(false);
+
+     for (int i = 0; i < count; i++) {
+	  transfer(commands[i]);
+     }
+
+     getTransport()->deselect();
+}
+
+void LCD::writeCommand(char command, bool extended)
+{
+     char commands[2];
+     int count = 0;
+     char function = 0x20 + (extended ? 1 : 0);
+
+     // Never read the state of the controller while a flush is changing it
+     waitFlush();
+
+     // Switch to the instruction set of the command only if needed, in the same transfer
+     if (m_function != function) {
+	  commands[count++] = function;
+     }
+
+     commands[count++] = command;
+
+     sendCommands(commands, count);
+
+     m_function = function;
+}
+
+void LCD::forgetState()
+{
+     // The next function set and cursor commands are sent whatever they are
+     m_function = -1;
+     m_cursorX = -1;
+     m_cursorY = -1;
+}
+
+bool LCD::takeDirty(unsigned char *first, unsigned char *last)
+{
+     // Count the changed bytes, and the number of row spans they form
+     int bytes = 0;
+     int spans = 0;
+
+     for (int i = 0; i < 6; i++) {
+	  first[i] = m_dirtyFirst[i];
+	  last[i] = m_dirtyLast[i];
+
+	  if (first[i] <= last[i]) {
+	       bytes += last[i] - first[i] + 1;
+	       spans++;
+	  }
+     }
+
+     // Every span costs two cursor commands, send the full frame if that is cheaper
+     if (spans > 0 && bytes + (spans * 2) >= 504 + 2) {
+	  for (int i = 0; i < 6; i++) {
+	       first[i] = 0;
+	       last[i] = 83;
+	  }
+
+	  bytes = 504;
+     }
+
+     LCD_STATS_ADD(skippedBytes, 504 - bytes);
+
+     setDirty(false);
+
+     return spans > 0;
+}
+
+bool LCD::nextSpan(const unsigned char *first, const unsigned char *last, int offset, int &row, int &start, int &count)
+{
+     // Skip the unchanged rows
+     while (row < 6 && first[row] > last[row]) {
+	  row++;
+     }
+
+     if (row >= 6) {
+	  return false;
+     }
+
+     start = (row * 84) + first[row];
+
+     // A span reaching the end of its row continues into a span at the start of the next row,
+     // as the cursor of the LCD screen wraps there, so both are sent in one transfer,
+     // unless the next row is at the start of the screen buffer
+     while (last[row] == 83 && row + 1 < 6 && first[row + 1] == 0 && (row + 1 + offset) % 6 != 0) {
+	  row++;
+     }
+
+     count = (row * 84) + last[row] + 1 - start;
+     row++;
+
+     return true;
+}
 
-	       // Shift the dot for the next row of screen pixels
-	       dot = dot << 1;
+int LCD::rotate(int position, int offset)
+{
+     return (((position / 84) + offset) % 6) * 84 + (position % 84);
+}
+
+void LCD::flushNext(void *lcd)
+{
+     LCD *self = (LCD *) lcd;
+     const char *screen = self->m_front ? self->m_front : self->m_screen;
+     int start;
+     int count;
+
+     // Called when the previous span completes, possibly from an interrupt
+     if (!self->nextSpan(self->m_flushFirst, self->m_flushLast, self->m_flushOffset, self->m_flushrow, start, count)) {
+	  self->m_flushing = false;
+
+	  if (self->m_flushcallback) {
+	       self->m_flushcallback();
 	  }
 
-	  // Shift the column for the next bitmap column
-	  column = column << 1;
+	  return;
+     }
+
+     // Let the transport set the cursor and send the span in the background, the cursor
+     // commands included, so nothing waits for a transfer when called from an interrupt
+     self->m_flushCursor[0] = 0x80 + (start % 84);
+     self->m_flushCursor[1] = 0x40 + (start / 84);
+
+#ifdef LCD_STATS
+     self->m_stats.commandBytes += 2;
+     self->m_stats.dataBytes += count;
+#endif
+
+     // The address counter ends up past the span
+     self->m_cursorX = (start + count) % 84;
+     self->m_cursorY = ((start + count) / 84) % 6;
+
+     self->getTransport()->transferAsync(self->m_flushCursor, 2, screen + rotate(start, self->m_flushOffset), count, flushNext, self);
+}
+
+LCD::RLEReader::RLEReader(const char *bitmap)
+{
+     // Read the header
+     width = pgm_read_byte(bitmap);
+     height = ((pgm_read_byte(bitmap + 1) / 8) + ((pgm_read_byte(bitmap + 1) % 8) > 0 ? 1 : 0));
+
+     m_data = bitmap + 2;
+     m_count = 0;
+     m_repeat = false;
+}
+
+char LCD::RLEReader::next()
+{
+     // Read the next control byte when the current run is over
+     if (m_count == 0) {
+	  unsigned char control = pgm_read_byte(m_data++);
+
+	  m_repeat = control >= 0x80;
+	  m_count = (control & 0x7F) + 1;
+
+	  if (m_repeat) {
+	       m_value = pgm_read_byte(m_data++);
+	  }
      }
+
+     m_count--;
+
+     // Repeat the value, or copy the next byte
+     return m_repeat ? m_value : pgm_read_byte(m_data++);
 }
@@ -2,6 +2,16 @@
 #define LCD_H_
 
 #include "Font.h"
+#include "GlyphCache.h"
+#include "Sprite.h"
+#include "Transport.h"
+
+// Define LCD_STATS to count what the LCD class does (getStats)
+// Without it the counters and the code updating them are left out, so the members of the
+// class depend on it: it must be defined for the library and every file including this header
+// alike, by uncommenting it here or in the flags of the whole build. Never define it in a sketch
+// before including this header, the sketch and the library would not agree on the class.
+// #define LCD_STATS
 
 class LCD
 {
@@ -13,6 +23,13 @@ public:
 	  WRAP_NEWLINE = 2
      };
 
+     // Enum to represent how the size of text and the scale of bitmaps are applied
+     enum scale_style {
+	  SCALE_POWER = 0,    // The actual scale is 2^(size - 1)
+	  SCALE_INTEGER = 1,  // The actual scale is size itself, 1 to 6 or 8
+	  SCALE_SMOOTH = 2    // Like SCALE_INTEGER, with the edges of even scales smoothed
+     };
+
      //Enum to represent the type of byte being sent to the LCD screen
      enum byte_type {
 	  COMMAND_BYTE = LOW,
@@ -62,9 +79,29 @@ public:
 	  REV_PORTRAIT = 3     // Portrait reversed, 90 degrees to the right of landscape
      };
 
+     // Size in bytes of the screen buffer, 6 rows of 84 columns stored row after row
+     static const int BUFFER_SIZE = 504;
+
+#ifdef LCD_STATS
+     // What the LCD class did since the last resetStats()
+     struct Stats {
+	  unsigned long dataBytes;       // Data bytes sent to the LCD screen
+	  unsigned long commandBytes;    // Command bytes sent to the LCD screen
+	  unsigned long flushes;         // Calls to flush() and flushAsync() that sent changed bytes
+	  unsigned long skippedBytes;    // Bytes of the screen buffer not sent by flushes as unchanged
+	  unsigned long glyphs;          // Characters written
+	  unsigned long renderMicros;    // Time spent drawing into the screen buffer
+	  unsigned long transferMicros;  // Time spent sending bytes, flushing or drawing directly
+     };
+#endif
+
      // Create an istance of the LCD class
      LCD(int clock = 2, int output = 3, int type = 4, int enable = 5, int reset = 6, int backlight = 7);
 
+     // Create an instance of the LCD class sending its bytes through the given transport
+     // The transport must outlive the LCD instance
+     LCD(Transport &transport, int reset = 6, int backlight = 7);
+
      // Initialize the LCD screen, and set the output to buffered or not
      bool init(bool buffered = true);
 
@@ -74,42 +111,189 @@ public:
 
      // Buffered function
      // Flush the contents of the screen buffer if the output is buffered
+     // Only the columns changed since the last flush are sent, unless most of the screen changed
      void flush();
 
+     // Buffered function
+     // Start flushing the changed contents of the screen buffer in the background
+     // The transport sends the bytes from interrupts if it can (SPITransport on AVR),
+     // otherwise the flush completes before returning. Returns false if not buffered,
+     // or if an asynchronous flush is already in progress.
+     // Unless double buffered, the screen buffer must not be drawn to until the flush completes.
+     bool flushAsync();
+
+     // Returns whether an asynchronous flush is in progress
+     bool isFlushing();
+
+     // Wait for the asynchronous flush in progress to complete
+     void waitFlush();
+
+     // Set the function called when an asynchronous flush completes
+     // With an SPITransport on AVR boards it runs in the SPI interrupt: keep it short, like
+     // setting a volatile flag for loop(), and start no flush or transfer from it.
+     void setFlushCallback(void (*callback)());
+
+     // Buffered function
+     // Set whether asynchronous flushes send a copy of the screen buffer (the front buffer),
+     // so drawing to the screen buffer can go on while the copy is being sent.
+     // The front buffer of BUFFER_SIZE bytes is allocated if not given.
+     bool setDoubleBuffered(bool doubleBuffered = true, char *front = 0);
+
+     // Returns whether asynchronous flushes send a copy of the screen buffer
+     bool isDoubleBuffered();
+
      // Set whether the output should be buffered or not
      bool setBuffered(bool buffered = true);
 
+     // Render the whole screen a strip of rows at a time, for sketches without the RAM of
+     // a screen buffer. draw is called once per strip, with the buffered functions drawing into
+     // a strip of rows * 84 bytes, clipped to it, then the strip is sent to the screen.
+     // draw must draw the same picture every time. The strip is given, or allocated for the call.
+     // Returns false if out of memory. The screen buffer, if any, is left as is, and sent
+     // whole on the next flush.
+     bool render(void (*draw)(), int rows = 1, char *strip = 0);
+
+     // Returns whether a render is in progress, in which case flush does nothing
+     bool isRendering();
+
+     // Returns the first screen row of the strip being rendered, 0 if not rendering
+     int getStripTop();
+
+     // Returns the number of screen rows of the strip being rendered, 6 if not rendering
+     int getStripRows();
+
      // Returns whether the output is being buffered or not
      bool isBuffered();
 
+     // Buffer the output in the given buffer of BUFFER_SIZE bytes, or stop buffering if 0
+     // The buffer is used as is and stays owned by the caller, so it can be a static array,
+     // or memory shared with other code. Calling it before init() makes init() use the buffer.
+     void setBuffer(char *buffer);
+
+     // Returns the screen buffer, byte (x, row) at index row * 84 + x, or 0 if not buffered
+     // After scrollRows the rows are rotated, byte (x, row) is at ((row + getRowOffset()) % 6) * 84 + x
+     char *getBuffer();
+
+     // Buffered function
+     // Scroll the screen buffer up by rows screen rows of 8 pixels, or down if rows is negative,
+     // clearing the rows coming in. The rows of the buffer are rotated instead of moved,
+     // and put back in order when sent, so only the rows coming in are written.
+     void scrollRows(int rows = 1);
+
+     // Returns the buffer row holding screen row 0, changed by scrollRows and reset by clear
+     int getRowOffset();
+
      // Writing/drawing related functions
      // Set the font to be used when writing
-     void setFont(Font font);
+     void setFont(const Font &font);
 
      // Get the font being used when writing
      Font getFont();
 
+     // Set the cache the glyphs are read through when writing, 0 to read them from the font
+     // The cache must outlive its use by the LCD instance
+     void setGlyphCache(GlyphCache *cache);
+
+     // Get the cache the glyphs are read through, 0 if none
+     GlyphCache *getGlyphCache();
+
      // Write a srtring to the LCD screen
      // If not buffered, will write the string directly using writeStringDirect(string, locx, locy / 8, inverted);
-     // The font's actual size will be 2^(size - 1)
+     // The font's actual size depends on the scale style, 2^(size - 1) by default
      void writeString(const char *string, int locx, int locy, int size = 1, bool inverted = false);
 
+     // Write a string with a font whose metrics are known at compile time, like writeString
+     // The columns of each character are read straight from the font data, without the
+     // glyph cache. If not buffered, writes directly with the font as a runtime Font.
+     template <int WIDTH, int HEIGHT, int FIRST, int COUNT>
+     void writeString(const FixedFont<WIDTH, HEIGHT, FIRST, COUNT> &font, const char *string, int locx, int locy, int size = 1, bool inverted = false);
+
      // Write a string directly to the LCD screen, not buffered
      // This method can only write on the 5 LCD screen rows individually (0 <= locy <= 5) with size 1
      void writeStringDirect(const char *string, int locx, int locy, bool inverted = false);
 
      // Draw the specified bitmap to the LCD screen
      // If not buffered, will draw the bitmap directly using drawBitmapDirect(bitmap, locx, locy / 8, width, height, inverted);
-     // The bitmaps actual scale will be 2^(scale - 1)
+     // The bitmaps actual scale depends on the scale style, 2^(scale - 1) by default
      void drawBitmap(char *bitmap, int locx, int locy, int width, int height, int scale = 1, bool inverted = false);
 
      // Draw the specified bitmap directly to the LCD screen
      // This method can only draw on the 5 LCD screen rows  (0 <= locy <= 5) with scale 1
      void drawBitmapDirect(char *bitmap, int locx, int locy, int width, int height, bool inverted = false);
 
+     // Draw the specified run-length encoded bitmap, stored in program memory (PROGMEM)
+     // The bitmap starts with its width and its height in pixels (a byte each), followed by
+     // its rows of 8 pixels, column by column like drawBitmap, packed in runs:
+     // a control byte 0x00 to 0x7F is followed by (control + 1) bytes copied as is,
+     // a control byte 0x80 to 0xFF is followed by a byte repeated (control - 0x80 + 1) times.
+     // extras/bitmap2rle.py converts PBM images to this format.
+     // The bitmap is decoded while drawing, and never stored in RAM.
+     // If not buffered, will draw the bitmap directly using drawBitmapRLEDirect(bitmap, locx, locy / 8, inverted);
+     // The bitmaps actual scale depends on the scale style, 2^(scale - 1) by default,
+     // the edges are not smoothed since the bitmap is decoded in a single pass
+     void drawBitmapRLE(const char *bitmap, int locx, int locy, int scale = 1, bool inverted = false);
+
+     // Draw the specified run-length encoded bitmap directly to the LCD screen
+     // This method can only draw on the 5 LCD screen rows  (0 <= locy <= 5) with scale 1
+     void drawBitmapRLEDirect(const char *bitmap, int locx, int locy, bool inverted = false);
+
+     // Buffered functions
+     // Draw shapes in the screen buffer, setting their pixels if on, clearing them otherwise
+     // Straight runs of pixels are written 8 rows at a time, as a byte mask per screen row
+     // Set the pixel at (x, y)
+     void drawPixel(int x, int y, bool on = true);
+
+     // Draw a horizontal line of width pixels starting at (x, y)
+     void drawHLine(int x, int y, int width, bool on = true);
+
+     // Draw a vertical line of height pixels starting at (x, y)
+     void drawVLine(int x, int y, int height, bool on = true);
+
+     // Draw a line from (x0, y0) to (x1, y1), both ends included
+     void drawLine(int x0, int y0, int x1, int y1, bool on = true);
+
+     // Draw the outline of a rectangle with its top left corner at (x, y)
+     void drawRect(int x, int y, int width, int height, bool on = true);
+
+     // Fill a rectangle with its top left corner at (x, y)
+     void fillRect(int x, int y, int width, int height, bool on = true);
+
+     // Draw the outline of a circle centered on (x, y)
+     void drawCircle(int x, int y, int radius, bool on = true);
+
+     // Draw the outline of a rectangle with corners rounded by radius pixels
+     void drawRoundRect(int x, int y, int width, int height, int radius, bool on = true);
+
+     // Buffered function
+     // Draw a sprite with its top left corner at (x, y), combined with the screen buffer by op
+     // Sprites are always drawn in landscape, a screen row at a time, shifted down by y % 8
+     void drawSprite(Sprite &sprite, int x, int y, Sprite::raster_op op = Sprite::OP_OR);
+
+     // Buffered function
+     // Copy an 8x8 tile stored in program memory (PROGMEM) to column 8 * column of screen row row,
+     // or clear it if tile is 0. Tiles are always drawn in landscape.
+     void drawTile(const char *tile, int column, int row);
+
+     // Buffered functions
+     // Scroll the pixels of the screen buffer by dx pixels to the right and dy pixels down,
+     // or to the left and up if negative, clearing the pixels coming in and dropping the ones
+     // going out. Scrolls are always done in landscape. Whole screen rows move with block moves,
+     // and vertical scrolls shift each column a screen row at a time, carrying the bits over.
+     void scroll(int dx, int dy);
+
+     // Scroll only the pixels of the window of width x height pixels with its top left corner
+     // at (x, y), the pixels around the window are left as is
+     void scroll(int dx, int dy, int x, int y, int width, int height);
+
      // Write a single byte to the LCD screen
      void writeByte(char byte, byte_type type);
 
+     // Write count bytes of the same type to the LCD screen in a single transfer
+     void writeBytes(const char *bytes, int count, byte_type type = DATA_BYTE);
+
+     // Write count bytes stored in program memory (PROGMEM) to the LCD screen in a single transfer
+     void writeBytes_P(const char *bytes, int count, byte_type type = DATA_BYTE);
+
      // Writing options functions
      // Set whether the output should be flushed automatically
      void setAutoFlush(bool flush = true);
@@ -123,6 +307,31 @@ public:
      // Get the current word wrap style
      wrap_style getWrapStyle();
 
+     // Set how the size of text and the scale of bitmaps are applied by the buffered functions
+     // SCALE_INTEGER and SCALE_SMOOTH scale by 1 to 6 or 8, other scales draw nothing.
+     // SCALE_SMOOTH scales by 2 the Scale2x (EPX) way, rounding the corners of diagonal edges,
+     // then scales the result by scale / 2, odd scales are not smoothed.
+     void setScaleStyle(scale_style style);
+
+     // Get the current scale style
+     scale_style getScaleStyle();
+
+     // Buffered function
+     // Set the orientation of the buffered drawing functions, the screen buffer keeps its layout
+     // In portrait the screen is 48 pixels wide and 84 pixels high, and text wraps at 48.
+     // Direct functions always draw in landscape, and so do drawSprite, drawTile, scroll,
+     // and scrollRows, which works on screen rows and is what Console scrolls with.
+     void setOrientation(orientation o);
+
+     // Get the current orientation
+     orientation getOrientation();
+
+     // Returns the width of the screen in pixels, in the current orientation
+     int getWidth();
+
+     // Returns the height of the screen in pixels, in the current orientation
+     int getHeight();
+
      // LCD Options
      // Set the LCD power down state on or off
      void setPowerDown(bool powerdown = true);
@@ -142,33 +351,257 @@ public:
      // Set the display mode of the LCD screen
      void setDisplayMode(display_mode mode);
 
+#ifdef LCD_STATS
+     // Statistics
+     // Returns a copy of the counters
+     // The bytes of an asynchronous flush are counted when it starts, its time is not counted
+     Stats getStats();
+
+     // Set all the counters to 0
+     void resetStats();
+#endif
+
 private:
+     // Groups of screens sharing lines send through the transport and flush the screen buffer
+     friend class LCDGroup;
+
      // The pins for this instance, initialized with constructor
-     int m_clock;
-     int m_output;
-     int m_type;
-     int m_enable;
      int m_reset;
      int m_backlight;
 
+     // The transport bytes are sent through
+     // The pin constructor leaves m_transport at 0 for m_bitbang, so copies send through their own
+     BitBangTransport m_bitbang; // Used by the pin constructor
+     Transport *m_transport;
+
      // Writing options
      bool m_autoflush; // Initially true
      wrap_style m_wrapstyle; // Initially WRAP_RETURN
+     scale_style m_scalestyle; // Initially SCALE_POWER
+     orientation m_orientation; // Initially LANDSCAPE
 
      // Screen buffer
-     char **m_screen; // Initially not initialized, setBuffered(true), or init(true) will initialize it
+     char *m_screen; // Initially not initialized, setBuffered(true), or init(true) will initialize it
+     bool m_ownscreen; // Whether m_screen was allocated by setBuffered
+
+     // Dirty columns of each screen row since the last flush, clean when first > last
+     unsigned char m_dirtyFirst[6];
+     unsigned char m_dirtyLast[6];
+
+     // Asynchronous flush
+     char *m_front; // Copy of the screen buffer being sent, 0 if not double buffered
+     bool m_ownfront; // Whether m_front was allocated by setDoubleBuffered
+     unsigned char m_flushFirst[6]; // The columns of each row being sent
+     unsigned char m_flushLast[6];
+     int m_flushrow; // The next row to send
+     int m_flushOffset; // The row offset of the screen buffer when the flush started
+     char m_flushCursor[2]; // The cursor commands of the span being sent
+     volatile bool m_flushing;
+     void (*m_flushcallback)();
+
+     // Block of up to 8 columns drawn in portrait, rotated into the screen buffer together
+     char m_block[8]; // Column x & 7 of the block
+     int m_blockX; // The left of the block, a multiple of 8
+     int m_blockY; // The top of the block
+     unsigned char m_blockColumns; // Bit i set if column i of the block was written
+
+     // Screen rows held by the screen buffer, only a strip of them while rendering
+     int m_stripTop; // Initially 0
+     int m_stripRows; // Initially 6
+     bool m_rendering;
+
+     // Buffer row holding screen row 0, screen row r is held by buffer row (r + m_rowOffset) % 6
+     int m_rowOffset; // Initially 0
+
+#ifdef LCD_STATS
+     // Statistics
+     Stats m_stats;
+     bool m_statsRender; // Whether render time is being measured
+     bool m_statsTransfer; // Whether transfer time is being measured
+#endif
+
+     // What the controller was last told, so commands that would not change it are left out
+     int m_function; // The last function set command, -1 if unknown
+     int m_cursorX; // The address counter, -1 if unknown
+     int m_cursorY;
+     bool m_selectedData; // Whether the bytes being sent are data bytes
 
      // Font
      Font m_font; // Initially uses DEFAULT_FONT from Font.h
+     GlyphCache *m_cache; // Initially 0, no cache
 
-     // Set the settings of the LCD screen
+     // Set the settings of the LCD screen, unless the controller already has them
      // powerdown = power down state
      // vertical = vertical (true) or horizontal (false) data entry
      // extended = function set of the LCD screen
      void set(bool powerdown, bool vertical, bool extended);
 
-     // Write a column to the screen buffer with a per-pixel location
-     void writeBuffered(char column, int locx, int locy, int cxoff, int cyoff, int size);
+     // Set the cursor of the LCD screen to column x of row y, sending only the addresses
+     // the address counter of the controller does not have already
+     void setCursor(int x, int y);
+
+     // Send a command of the normal or extended function set, preceded by the function set
+     // command in the same transfer if the controller is not using that set already
+     void writeCommand(char command, bool extended);
+
+     // Send command bytes in a single transfer, without forgetting the state of the controller
+     void sendCommands(const char *commands, int count);
+
+     // Forget what the controller was told, after a reset or commands sent by the sketch
+     void forgetState();
+
+     // Decoder of run-length encoded bitmaps, see drawBitmapRLE
+     class RLEReader
+     {
+     public:
+	  // Start decoding the bitmap in program memory, reading its header
+	  RLEReader(const char *bitmap);
+
+	  // Returns the next byte of the bitmap
+	  char next();
+
+	  // The width of the bitmap, and its height in screen rows
+	  int width;
+	  int height;
+
+     private:
+	  // The next byte to read
+	  const char *m_data;
+
+	  // The bytes left in the current run, and whether it repeats m_value
+	  int m_count;
+	  bool m_repeat;
+	  char m_value;
+     };
+
+     // Initialize the members shared by all constructors
+     void setDefaults();
+
+     // Enable the chip for a transfer, after waiting for an asynchronous flush to complete
+     void select(bool data);
+
+     // Returns the transport bytes are sent through
+     Transport *getTransport();
+
+     // Send a byte while the chip is enabled, following the address counter for data bytes,
+     // and counting it if LCD_STATS is defined
+     void transfer(char byte);
+
+     // Copy the changed spans of every row to first and last, widened to the whole screen
+     // if a full frame is cheaper to send, and mark the screen as unchanged.
+     // Returns false if nothing changed since the last flush.
+     bool takeDirty(unsigned char *first, unsigned char *last);
+
+     // Find the next span to send starting at row, spans continuing on the next row are merged
+     // unless the rows are apart in a screen buffer with the given row offset
+     // Sets start (position row * 84 + x on the screen) and count, and moves row past the span.
+     // Returns false if no span is left.
+     bool nextSpan(const unsigned char *first, const unsigned char *last, int offset, int &row, int &start, int &count);
+
+     // Returns the index in a screen buffer with the given row offset of the byte at position
+     // row * 84 + x on the screen
+     static int rotate(int position, int offset);
+
+     // Send the next span of an asynchronous flush, called when the previous one completes
+     static void flushNext(void *lcd);
+
+     // Write a column to the screen buffer with its top pixel at (x, y), replacing 8 pixels
+     // (x, y) is in the current orientation, in portrait the column goes to the block first
+     void writeColumn(char column, int x, int y);
+
+     // Write the pixels of a landscape column selected by mask to the screen buffer,
+     // with its top pixel at (x, y)
+     void writeMasked(char column, char mask, int x, int y);
+
+     // Returns the columns of screen row row in the buffer, 0 if the buffer does not hold it
+     char *getRow(int row);
+
+     // Rotate the block of portrait columns into the screen buffer, and empty it
+     // Every buffered drawing function calls it once done
+     void commitBlock();
+
+     // Write the columns of a character stored in program memory, rows bytes each, or blank
+     // columns if glyph is 0, scaled like writeScaled with the top left pixel at (x, y)
+     void writeGlyph(const char *glyph, int width, int rows, int x, int y, int scale, bool inverted);
+
+     // Returns the actual scale of the given text size or bitmap scale, for the scale style
+     int getScale(int size);
+
+     // Write a column scaled by 1 to 6 or 8 to the screen buffer with its top left pixel at (x, y)
+     // Every bit becomes a scale x scale square, built from the scaling tables a byte at a time
+     void writeScaled(char column, int x, int y, int scale);
+
+     // Write a column like writeScaled, smoothing its edges the Scale2x way if scale is even
+     // left and right are the columns beside it, above and below the columns of the screen
+     // rows above and below it, blank outside of the character or bitmap
+     void writeSmoothed(char left, char column, char right, char above, char below, int x, int y, int scale);
+
+     // Set or clear the pixels from (x0, y0) to (x1, y1) inclusive, x0 <= x1 and y0 <= y1
+     // The rectangle is in the current orientation, it is clipped and rotated as a whole
+     void fillSpan(int x0, int y0, int x1, int y1, bool on);
+
+     // Move the columns x0 to x1 (inclusive) of screen row row by dx columns, only their pixels
+     // selected by mask, clearing the columns coming in
+     void scrollColumns(int dx, int x0, int x1, int row, unsigned char mask);
+
+     // Shift column x of screen rows row0 to row1 (inclusive) by dy pixels, only the pixels
+     // selected by the mask of each row, clearing the pixels coming in
+     void shiftColumn(int dy, int x, int row0, int row1, const unsigned char *masks);
+
+     // Draw the four quarter circles of radius r used by drawCircle and drawRoundRect,
+     // with their centers at the corners of the rectangle from (x0, y0) to (x1, y1)
+     void drawArcs(int x0, int y0, int x1, int y1, int r, bool on);
+
+     // Mark the columns first to last (inclusive) of screen row ry as changed since the last flush
+     void setDirty(int ry, int first, int last);
+
+     // Mark the whole screen as changed, or unchanged, since the last flush
+     void setDirty(bool dirty);
 };
 
+template <int WIDTH, int HEIGHT, int FIRST, int COUNT>
+void LCD::writeString(const FixedFont<WIDTH, HEIGHT, FIRST, COUNT> &font, const char *string, int locx, int locy, int size, bool inverted)
+{
+     // If not buffered, write direct with the font as a runtime font
+     if (!m_screen) {
+	  Font previous = m_font;
+
+	  m_font = font.toFont();
+	  writeStringDirect(string, locx, locy / 8, inverted);
+	  m_font = previous;
+
+	  return;
+     }
+
+     // Every character advances by the same width, known at compile time
+     int scale = getScale(size);
+     int advance = WIDTH * scale;
+     int x = locx;
+     int y = locy;
+
+     while (*string != 0) {
+	  writeGlyph(font.getChar((unsigned char) *string), WIDTH, font.ROWS, x, y, scale, inverted);
+
+	  x += advance;
+
+	  // If there is a wrap style, go to the next line when the next character does not fit
+	  if (m_wrapstyle != NO_WRAP && x + advance >= getWidth()) {
+	       y += 8 * scale * font.ROWS;
+
+	       // If we are wrapping without new line, go back to beginning of the row
+	       x = m_wrapstyle == WRAP_RETURN ? 0 : locx;
+	  }
+
+	  // Go to the next character
+	  string++;
+     }
+
+     commitBlock();
+
+     // Flush the screen buffer
+     if (m_autoflush) {
+	  flush();
+     }
+}
+
 #endif /* LCD_H_ */
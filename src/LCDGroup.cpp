@@ -0,0 +1,216 @@
+#include <Arduino.h>
+#include "LCDGroup.h"
+
+LCDGroup::LCDGroup()
+{
+     // Initialize the members of the LCDGroup class
+     m_count = 0;
+}
+
+bool LCDGroup::add(LCD &lcd)
+{
+     // Make sure the group has room left
+     if (m_count >= MAX_SCREENS) {
+	  return false;
+     }
+
+     m_screens[m_count++] = &lcd;
+
+     return true;
+}
+
+int LCDGroup::getCount()
+{
+     return m_count;
+}
+
+LCD *LCDGroup::getScreen(int index)
+{
+     // Return 0 if out of bounds
+     if (index < 0 || index >= m_count) {
+	  return 0;
+     }
+
+     return m_screens[index];
+}
+
+bool LCDGroup::init(bool buffered)
+{
+     // Set every enable line high before any screen is sent its first byte
+     for (int i = 0; i < m_count; i++) {
+	  m_screens[i]->getTransport()->begin();
+     }
+
+     // Initialize the screens one after the other
+     for (int i = 0; i < m_count; i++) {
+	  if (!m_screens[i]->init(buffered)) {
+	       return false;
+	  }
+     }
+
+     return true;
+}
+
+void LCDGroup::flush()
+{
+     unsigned char first[MAX_SCREENS][6];
+     unsigned char last[MAX_SCREENS][6];
+     int row[MAX_SCREENS];
+     int start[MAX_SCREENS];
+     int count[MAX_SCREENS];
+     unsigned char pending = 0;
+     unsigned char screens = 0;
+
+     // Take the changed spans of every screen, with its next span to send
+     for (int i = 0; i < m_count; i++) {
+	  LCD *lcd = m_screens[i];
+
+#ifdef LCD_STATS
+	  lcd->m_stats.flushes++;
+#endif
+
+	  // If not buffered, or while rendering, there is nothing to flush
+	  if (!lcd->m_screen || lcd->m_rendering) {
+	       continue;
+	  }
+
+	  // Let an asynchronous flush finish first, so it does not overwrite newer contents
+	  lcd->waitFlush();
+
+	  row[i] = 0;
+
+	  if (lcd->takeDirty(first[i], last[i]) && lcd->nextSpan(first[i], last[i], lcd->m_rowOffset, row[i], start[i], count[i])) {
+	       pending |= 1 << i;
+	  }
+     }
+
+     // Set the screen settings for output, once for the screens not using them already
+     for (int i = 0; i < m_count; i++) {
+	  if ((pending & (1 << i)) && m_screens[i]->m_function != 0x20) {
+	       screens |= 1 << i;
+	  }
+     }
+
+     if (screens) {
+	  char function = 0x20;
+
+	  sendBytes(screens, &function, 1, false);
+
+	  for (int i = 0; i < m_count; i++) {
+	       if (screens & (1 << i)) {
+		    m_screens[i]->m_function = function;
+	       }
+	  }
+     }
+
+     // Write the spans, the one starting first on any screen next
+     while (pending) {
+	  int next = LCD::BUFFER_SIZE;
+	  char cursor[2];
+	  int commands = 0;
+	  bool sendX = false;
+	  bool sendY = false;
+
+	  for (int i = 0; i < m_count; i++) {
+	       if ((pending & (1 << i)) && start[i] < next) {
+		    next = start[i];
+	       }
+	  }
+
+	  // The screens with a span starting there, and the cursor commands they need
+	  screens = 0;
+
+	  for (int i = 0; i < m_count; i++) {
+	       if ((pending & (1 << i)) && start[i] == next) {
+		    screens |= 1 << i;
+		    sendX = sendX || m_screens[i]->m_cursorX != next % 84;
+		    sendY = sendY || m_screens[i]->m_cursorY != next / 84;
+	       }
+	  }
+
+	  // Set the cursor of all of them together, the address a screen has already is
+	  // sent again if another one needs it
+	  if (sendX) {
+	       cursor[commands++] = 0x80 + (next % 84);
+	  }
+
+	  if (sendY) {
+	       cursor[commands++] = 0x40 + (next / 84);
+	  }
+
+	  if (commands > 0) {
+	       sendBytes(screens, cursor, commands, false);
+	  }
+
+	  // Then send the span of each screen, once to all the screens with the same bytes there
+	  for (int i = 0; i < m_count; i++) {
+	       if (!(screens & (1 << i))) {
+		    continue;
+	       }
+
+	       const char *bytes = m_screens[i]->m_screen + LCD::rotate(next, m_screens[i]->m_rowOffset);
+	       unsigned char same = 1 << i;
+
+	       for (int j = i + 1; j < m_count; j++) {
+		    if ((screens & (1 << j)) && count[j] == count[i] && memcmp(m_screens[j]->m_screen + LCD::rotate(next, m_screens[j]->m_rowOffset), bytes, count[i]) == 0) {
+			 same |= 1 << j;
+		    }
+	       }
+
+	       sendBytes(same, bytes, count[i], true);
+
+	       // The address counters of the screens end up past the span
+	       for (int j = i; j < m_count; j++) {
+		    if (!(same & (1 << j))) {
+			 continue;
+		    }
+
+		    LCD *lcd = m_screens[j];
+
+		    lcd->m_cursorX = (next + count[j]) % 84;
+		    lcd->m_cursorY = ((next + count[j]) / 84) % 6;
+
+		    if (!lcd->nextSpan(first[j], last[j], lcd->m_rowOffset, row[j], start[j], count[j])) {
+			 pending &= ~(1 << j);
+		    }
+	       }
+
+	       screens &= ~same;
+	  }
+     }
+}
+
+void LCDGroup::sendBytes(unsigned char screens, const char *bytes, int count, bool data)
+{
+     LCD *sender = 0;
+
+     // The first screen of the mask clocks the bytes out on the shared lines, in a transfer
+     // of its own, the others are only enabled to read them
+     for (int i = 0; i < m_count; i++) {
+	  if (!(screens & (1 << i))) {
+	       continue;
+	  }
+
+	  if (!sender) {
+	       sender = m_screens[i];
+	       sender->select(data);
+	  }
+	  else {
+	       m_screens[i]->waitFlush();
+	       m_screens[i]->getTransport()->selectShared(data);
+	  }
+     }
+
+     for (int i = 0; i < count; i++) {
+	  sender->transfer(bytes[i]);
+     }
+
+     // Disable the others first, then end the transfer of the sender
+     for (int i = 0; i < m_count; i++) {
+	  if ((screens & (1 << i)) && m_screens[i] != sender) {
+	       m_screens[i]->getTransport()->deselectShared();
+	  }
+     }
+
+     sender->getTransport()->deselect();
+}
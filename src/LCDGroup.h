@@ -0,0 +1,55 @@
+#ifndef LCDGROUP_H_
+#define LCDGROUP_H_
+
+#include "LCD.h"
+
+// Group of LCD screens sharing the clock, output and type lines, each with its own enable line
+// Create every LCD of the group with the same clock, output and type pins and a different
+// enable pin, or with transports of the same kind sharing those lines (SPITransport instances
+// with the same type pin). The group sends through the transports of its screens, enabling
+// several of them together for the bytes they all need, which are clocked into all at once:
+// the transport of one screen makes the transfer, SPI transaction included, and the others
+// are only enabled (Transport::selectShared).
+class LCDGroup
+{
+public:
+     // Most screens in a group
+     static const int MAX_SCREENS = 4;
+
+     // Create an empty group
+     LCDGroup();
+
+     // Add a screen to the group, returns false if the group is full
+     // The LCD instance must outlive its use by the group
+     bool add(LCD &lcd);
+
+     // Returns the number of screens in the group
+     int getCount();
+
+     // Returns the screen at the given index, 0 if out of bounds
+     LCD *getScreen(int index);
+
+     // Initialize every screen of the group like LCD::init
+     // Every enable line is set high first, so a screen does not read the bytes of another
+     // screen being initialized. Returns false if a screen could not be initialized.
+     bool init(bool buffered = true);
+
+     // Buffered function
+     // Flush the changed contents of the screen buffers of every buffered screen, like LCD::flush
+     // The spans of all the screens are sent in order of position, the function set and cursor
+     // commands wanted by several screens are sent once to all of them, then the data bytes of
+     // each screen, once to all the screens with the same bytes in a span. Screens being
+     // rendered are left out. The time spent is not counted in the statistics of the screens.
+     void flush();
+
+private:
+     // The screens of the group
+     LCD *m_screens[MAX_SCREENS];
+     int m_count;
+
+     // Send bytes of the same type in a single transfer to the screens of the mask, bit i for
+     // screen i, enabled together. The bytes are counted in the statistics of the first one.
+     void sendBytes(unsigned char screens, const char *bytes, int count, bool data);
+};
+
+#endif /* LCDGROUP_H_ */
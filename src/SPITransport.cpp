@@ -0,0 +1,195 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include "SPITransport.h"
+
+SPITransport *volatile SPITransport::s_active = 0;
+SPITransport *volatile SPITransport::s_chained = 0;
+
+SPITransport::SPITransport(int type, int enable, unsigned long speed)
+     : m_settings(speed, MSBFIRST, SPI_MODE0)
+{
+     // Initialize the pins of the transport
+     m_type = type;
+     m_enable = enable;
+
+     m_asyncCommands = 0;
+     m_asyncCommandCount = 0;
+     m_async = 0;
+     m_asyncCount = 0;
+     m_asyncData = false;
+}
+
+void SPITransport::begin()
+{
+     // Initialize the type pin to low, and enable, which is active LOW, to high
+     pinMode(m_type, OUTPUT);
+     digitalWrite(m_type, LOW);
+
+     pinMode(m_enable, OUTPUT);
+     digitalWrite(m_enable, HIGH);
+
+     // Set up the SPI peripheral, which takes over the clock and output pins
+     SPI.begin();
+}
+
+void SPITransport::select(bool data)
+{
+     // Wait for the asynchronous transfer in progress
+     wait();
+
+     SPI.beginTransaction(m_settings);
+
+     // Set the chip to look for clock cycles
+     digitalWrite(m_enable, LOW);
+     // Set the byte type
+     digitalWrite(m_type, data ? HIGH : LOW);
+}
+
+void SPITransport::transfer(char byte)
+{
+     // Shift the byte out, high bit first
+     SPI.transfer(byte);
+}
+
+void SPITransport::deselect()
+{
+     // Set the chip to ignore clock cycles
+     digitalWrite(m_enable, HIGH);
+
+     SPI.endTransaction();
+}
+
+void SPITransport::selectShared(bool data)
+{
+     // Wait for the asynchronous transfer in progress
+     wait();
+
+     // Set the chip to look for clock cycles, and the byte type
+     digitalWrite(m_enable, LOW);
+     digitalWrite(m_type, data ? HIGH : LOW);
+}
+
+void SPITransport::deselectShared()
+{
+     // Set the chip to ignore clock cycles
+     digitalWrite(m_enable, HIGH);
+}
+
+bool SPITransport::transferAsync(const char *commands, int commandCount, const char *bytes, int count, Callback done, void *context)
+{
+#ifdef LCD_SPI_ASYNC
+     // Nothing to send in the background
+     if (commandCount + count <= 0) {
+	  return Transport::transferAsync(commands, commandCount, bytes, count, done, context);
+     }
+
+     // Only the transport calling back may start a transfer from the callback
+     if (s_active || (s_chained && s_chained != this)) {
+	  return false;
+     }
+
+     if (s_chained == this) {
+	  // The chip is still enabled and the SPI transaction still going, only set the type
+	  s_chained = 0;
+	  digitalWrite(m_type, commandCount > 0 ? LOW : HIGH);
+     }
+     else {
+	  select(commandCount == 0);
+     }
+
+     // Keep the transfer for the interrupt
+     m_asyncCommands = commands;
+     m_asyncCommandCount = commandCount;
+     m_async = bytes;
+     m_asyncCount = count;
+     m_asyncData = commandCount == 0;
+     m_done = done;
+     m_context = context;
+     s_active = this;
+
+     // Enable the transfer complete interrupt, and send the first byte
+     SPCR |= _BV(SPIE);
+     sendNext();
+
+     return true;
+#else
+     // No interrupt on this board, send the bytes right away
+     return Transport::transferAsync(commands, commandCount, bytes, count, done, context);
+#endif
+}
+
+bool SPITransport::isBusy()
+{
+     return s_active == this;
+}
+
+void SPITransport::wait()
+{
+     // The interrupt clears s_active when the last byte is sent
+     while (s_active == this) {
+     }
+}
+
+void SPITransport::handleInterrupt()
+{
+#ifdef LCD_SPI_ASYNC
+     SPITransport *transport = s_active;
+
+     if (!transport) {
+	  return;
+     }
+
+     // Send the next byte
+     if (transport->sendNext()) {
+	  return;
+     }
+
+     // The last byte was sent, disable the interrupt
+     SPCR &= ~_BV(SPIE);
+     s_active = 0;
+
+     // The callback may start the next transfer, which keeps the chip enabled
+     s_chained = transport;
+     transport->m_done(transport->m_context);
+
+     // No transfer followed, disable the chip and end the SPI transaction
+     if (s_chained == transport) {
+	  s_chained = 0;
+	  transport->deselect();
+     }
+#endif
+}
+
+bool SPITransport::sendNext()
+{
+#ifdef LCD_SPI_ASYNC
+     if (m_asyncCommandCount > 0) {
+	  m_asyncCommandCount--;
+	  SPDR = *m_asyncCommands++;
+	  return true;
+     }
+
+     if (m_asyncCount > 0) {
+	  // The last command byte is out, the chip reads the type with the last bit of each byte
+	  if (!m_asyncData) {
+	       digitalWrite(m_type, HIGH);
+	       m_asyncData = true;
+	  }
+
+	  m_asyncCount--;
+	  SPDR = *m_async++;
+	  return true;
+     }
+#endif
+
+     return false;
+}
+
+#ifdef LCD_SPI_ASYNC
+
+ISR(SPI_STC_vect)
+{
+     SPITransport::handleInterrupt();
+}
+
+#endif
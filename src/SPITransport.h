@@ -0,0 +1,86 @@
+#ifndef SPITRANSPORT_H_
+#define SPITRANSPORT_H_
+
+#include <SPI.h>
+#include "Transport.h"
+
+// On AVR boards asynchronous transfers are driven by the SPI transfer complete interrupt
+// Define LCD_NO_SPI_ISR if another library needs the SPI_STC_vect interrupt
+#if defined(__AVR__) && !defined(LCD_NO_SPI_ISR)
+#define LCD_SPI_ASYNC
+#endif
+
+// Transport using the hardware SPI peripheral to shift the bytes out
+// The LCD clock and output lines must be wired to the SCK and MOSI pins of the board
+// (13 and 11 on the Uno), the type and enable pins can be any pins
+// For asynchronous transfers, a byte at 4 MHz takes about as long as the interrupt sending it,
+// so a lower speed (1 MHz) leaves more time to the sketch during a flush.
+class SPITransport : public Transport
+{
+public:
+     // Create a hardware SPI transport, the PCD8544 accepts serial clocks up to 4 MHz
+     SPITransport(int type = 4, int enable = 5, unsigned long speed = 4000000);
+
+     // Set up the SPI peripheral and the type and enable pins, leaving the chip disabled
+     virtual void begin();
+
+     // Enable the chip for a transfer of data bytes, or command bytes
+     virtual void select(bool data);
+
+     // Send a single byte through the SPI peripheral, high bit first
+     virtual void transfer(char byte);
+
+     // Disable the chip at the end of a transfer
+     virtual void deselect();
+
+     // Enable the chip for the bytes another SPITransport sends, only setting its pins,
+     // so the SPI transaction is begun once by the sending transport
+     virtual void selectShared(bool data);
+
+     // Disable the chip enabled with selectShared, leaving the SPI transaction to the sender
+     virtual void deselectShared();
+
+     // Start sending commandCount command bytes, then count data bytes, from the SPI interrupt,
+     // one byte per interrupt. A transfer started by the callback of the one that completed goes
+     // on with the chip enabled and in the same SPI transaction, so the interrupt never waits.
+     // Other transports are refused until the callback returns.
+     virtual bool transferAsync(const char *commands, int commandCount, const char *bytes, int count, Callback done, void *context);
+
+     // Returns whether an asynchronous transfer is in progress
+     virtual bool isBusy();
+
+     // Wait for the asynchronous transfer in progress to complete
+     virtual void wait();
+
+     // Send the next byte of the asynchronous transfer, called from the SPI interrupt
+     static void handleInterrupt();
+
+private:
+     // The type and enable pins, initialized with the constructor
+     int m_type;
+     int m_enable;
+
+     // The SPI clock speed, mode and bit order
+     SPISettings m_settings;
+
+     // The asynchronous transfer in progress, its command bytes sent first
+     const char *m_asyncCommands;
+     int m_asyncCommandCount;
+     const char *m_async;
+     int m_asyncCount;
+     bool m_asyncData; // Whether the type pin is set for data bytes
+     Callback m_done;
+     void *m_context;
+
+     // The transport with an asynchronous transfer in progress, 0 if none
+     static SPITransport *volatile s_active;
+
+     // The transport whose completed transfer is calling back, 0 if none
+     static SPITransport *volatile s_chained;
+
+     // Send the next byte of the asynchronous transfer, setting the type pin for the first data
+     // byte. Returns false if no byte is left.
+     bool sendNext();
+};
+
+#endif /* SPITRANSPORT_H_ */
@@ -0,0 +1,358 @@
+#include <stdlib.h>
+#include <string.h>
+#include <Arduino.h>
+#include "LCD.h"
+#include "Sprite.h"
+
+Sprite::Sprite(const char *bitmap, int width, int height, const char *mask)
+{
+     // Initialize the sprite, not preshifted
+     m_bitmap = bitmap;
+     m_mask = mask;
+     m_width = width;
+     m_height = height;
+     m_rows = (height / 8) + ((height % 8) > 0 ? 1 : 0);
+     m_shifted = 0;
+     m_ownshifted = false;
+}
+
+Sprite::~Sprite()
+{
+     if (m_ownshifted) {
+	  free(m_shifted);
+     }
+}
+
+bool Sprite::preshift(char *buffer)
+{
+     int rowsSize = (m_rows + 1) * m_width;
+     bool allocated = false;
+
+     // Allocate the shifted copies if no buffer was given
+     if (!buffer) {
+	  buffer = (char *) malloc(getPreshiftSize());
+
+	  if (!buffer) {
+	       return false;
+	  }
+
+	  allocated = true;
+     }
+
+     // Shift the bitmap and the mask once for every shift
+     for (int shift = 0; shift < 8; shift++) {
+	  char *copy = buffer + (shift * rowsSize * (m_mask ? 2 : 1));
+
+	  for (int y = 0; y <= m_rows; y++) {
+	       for (int x = 0; x < m_width; x++) {
+		    copy[(y * m_width) + x] = shiftColumn(m_bitmap, x, y, shift);
+
+		    if (m_mask) {
+			 copy[rowsSize + (y * m_width) + x] = shiftColumn(m_mask, x, y, shift);
+		    }
+	       }
+	  }
+     }
+
+     // Replace the previous copies
+     if (m_ownshifted) {
+	  free(m_shifted);
+     }
+
+     m_shifted = buffer;
+     m_ownshifted = allocated;
+
+     return true;
+}
+
+int Sprite::getPreshiftSize()
+{
+     // 8 shifts of one more row than the sprite, for the bitmap and the mask
+     return 8 * (m_rows + 1) * m_width * (m_mask ? 2 : 1);
+}
+
+int Sprite::getWidth()
+{
+     return m_width;
+}
+
+int Sprite::getHeight()
+{
+     return m_height;
+}
+
+int Sprite::getRows()
+{
+     return m_rows;
+}
+
+void Sprite::getColumn(int x, int y, int shift, unsigned char &bits, unsigned char &mask)
+{
+     // Read the shifted copies if there are any
+     if (m_shifted) {
+	  int rowsSize = (m_rows + 1) * m_width;
+	  const char *copy = m_shifted + (shift * rowsSize * (m_mask ? 2 : 1)) + (y * m_width) + x;
+
+	  bits = copy[0];
+	  mask = m_mask ? copy[rowsSize] : 0;
+	  return;
+     }
+
+     // Otherwise shift the column now
+     bits = shiftColumn(m_bitmap, x, y, shift);
+     mask = m_mask ? shiftColumn(m_mask, x, y, shift) : 0;
+}
+
+unsigned char Sprite::shiftColumn(const char *source, int x, int y, int shift)
+{
+     // The column of row y gets its top from row y, and its bottom from row y - 1
+     unsigned char top = y < m_rows ? source[(y * m_width) + x] : 0;
+     unsigned char bottom = (y > 0 && shift > 0) ? source[((y - 1) * m_width) + x] : 0;
+
+     return (top << shift) | (bottom >> (8 - shift));
+}
+
+TileMap::TileMap(const char *tiles, unsigned char *map, int columns, int rows)
+{
+     // Initialize the map
+     m_tiles = tiles;
+     m_map = map;
+     m_columns = columns;
+     m_rows = rows;
+}
+
+void TileMap::setTile(int column, int row, unsigned char tile)
+{
+     // Ignore places out of bounds
+     if (column < 0 || column >= m_columns || row < 0 || row >= m_rows) {
+	  return;
+     }
+
+     m_map[(row * m_columns) + column] = tile;
+}
+
+unsigned char TileMap::getTile(int column, int row)
+{
+     // Return 0 if out of bounds
+     if (column < 0 || column >= m_columns || row < 0 || row >= m_rows) {
+	  return 0;
+     }
+
+     return m_map[(row * m_columns) + column];
+}
+
+const char *TileMap::getTileData(int column, int row)
+{
+     // Every tile is 8 columns
+     return m_tiles + (getTile(column, row) * 8);
+}
+
+int TileMap::getColumns()
+{
+     return m_columns;
+}
+
+int TileMap::getRows()
+{
+     return m_rows;
+}
+
+SpriteLayer::SpriteLayer(TileMap *background, int count)
+{
+     // Allocate the slots, all hidden
+     m_slots = (Slot *) malloc(count * sizeof(Slot));
+
+     if (!m_slots) {
+	  count = 0;
+     }
+
+     for (int i = 0; i < count; i++) {
+	  m_slots[i].sprite = 0;
+	  m_slots[i].op = Sprite::OP_OR;
+	  m_slots[i].x = 0;
+	  m_slots[i].y = 0;
+	  m_slots[i].visible = false;
+	  m_slots[i].changed = false;
+	  m_slots[i].drawn = false;
+     }
+
+     m_count = count;
+     m_background = background;
+
+     // The first draw draws the whole background
+     invalidate();
+}
+
+SpriteLayer::~SpriteLayer()
+{
+     free(m_slots);
+}
+
+void SpriteLayer::setSprite(int index, Sprite *sprite, Sprite::raster_op op)
+{
+     if (index < 0 || index >= m_count) {
+	  return;
+     }
+
+     m_slots[index].sprite = sprite;
+     m_slots[index].op = op;
+     m_slots[index].changed = true;
+}
+
+void SpriteLayer::move(int index, int x, int y)
+{
+     if (index < 0 || index >= m_count) {
+	  return;
+     }
+
+     // Nothing to redraw if the sprite stays in place
+     if (m_slots[index].x != x || m_slots[index].y != y) {
+	  m_slots[index].x = x;
+	  m_slots[index].y = y;
+	  m_slots[index].changed = true;
+     }
+}
+
+void SpriteLayer::show(int index, bool visible)
+{
+     if (index < 0 || index >= m_count) {
+	  return;
+     }
+
+     if (m_slots[index].visible != visible) {
+	  m_slots[index].visible = visible;
+	  m_slots[index].changed = true;
+     }
+}
+
+void SpriteLayer::invalidate()
+{
+     // Restore every tile
+     for (int i = 0; i < 6; i++) {
+	  m_dirty[i] = ~0;
+     }
+}
+
+void SpriteLayer::draw(LCD &lcd)
+{
+     // Flush once at the end, instead of after every tile and sprite
+     bool autoflush = lcd.isAutoFlush();
+
+     lcd.setAutoFlush(false);
+
+     // Restore the tiles under the sprites that changed, where they were and where they are now
+     for (int i = 0; i < m_count; i++) {
+	  Slot &slot = m_slots[i];
+
+	  if (!slot.changed) {
+	       continue;
+	  }
+
+	  if (slot.drawn) {
+	       markTiles(slot.drawnX, slot.drawnY, slot.drawnWidth, slot.drawnHeight);
+	  }
+
+	  if (slot.visible && slot.sprite) {
+	       markTiles(slot.x, slot.y, slot.sprite->getWidth(), slot.sprite->getHeight());
+	  }
+     }
+
+     // A sprite over a restored tile is redrawn whole, drawing it again in place would
+     // undo it with OP_XOR, so the other tiles under it are restored too, until no sprite
+     // is partly over restored tiles
+     bool grown = true;
+
+     while (grown) {
+	  grown = false;
+
+	  for (int i = 0; i < m_count; i++) {
+	       Slot &slot = m_slots[i];
+
+	       if (slot.visible && slot.sprite && isDirty(slot.x, slot.y, slot.sprite->getWidth(), slot.sprite->getHeight())) {
+		    grown = markTiles(slot.x, slot.y, slot.sprite->getWidth(), slot.sprite->getHeight()) || grown;
+	       }
+	  }
+     }
+
+     // Restore the tiles
+     for (int row = 0; row < 6; row++) {
+	  for (int column = 0; column < 11; column++) {
+	       if (m_dirty[row] & (1 << column)) {
+		    lcd.drawTile(m_background ? m_background->getTileData(column, row) : 0, column, row);
+	       }
+	  }
+     }
+
+     // Draw the sprites over restored tiles, in order
+     for (int i = 0; i < m_count; i++) {
+	  Slot &slot = m_slots[i];
+
+	  slot.changed = false;
+	  slot.drawn = slot.visible && slot.sprite;
+
+	  if (!slot.drawn) {
+	       continue;
+	  }
+
+	  slot.drawnX = slot.x;
+	  slot.drawnY = slot.y;
+	  slot.drawnWidth = slot.sprite->getWidth();
+	  slot.drawnHeight = slot.sprite->getHeight();
+
+	  if (isDirty(slot.x, slot.y, slot.drawnWidth, slot.drawnHeight)) {
+	       lcd.drawSprite(*slot.sprite, slot.x, slot.y, slot.op);
+	  }
+     }
+
+     for (int i = 0; i < 6; i++) {
+	  m_dirty[i] = 0;
+     }
+
+     // Flush the screen buffer
+     lcd.setAutoFlush(autoflush);
+
+     if (autoflush) {
+	  lcd.flush();
+     }
+}
+
+bool SpriteLayer::markTiles(int x, int y, int width, int height)
+{
+     bool marked = false;
+
+     // Clip the tiles to the screen
+     int first = max(x >> 3, 0);
+     int last = min((x + width - 1) >> 3, 10);
+     int top = max(y >> 3, 0);
+     int bottom = min((y + height - 1) >> 3, 5);
+
+     for (int row = top; row <= bottom; row++) {
+	  for (int column = first; column <= last; column++) {
+	       if (!(m_dirty[row] & (1 << column))) {
+		    m_dirty[row] |= 1 << column;
+		    marked = true;
+	       }
+	  }
+     }
+
+     return marked;
+}
+
+bool SpriteLayer::isDirty(int x, int y, int width, int height)
+{
+     // Clip the tiles to the screen
+     int first = max(x >> 3, 0);
+     int last = min((x + width - 1) >> 3, 10);
+     int top = max(y >> 3, 0);
+     int bottom = min((y + height - 1) >> 3, 5);
+
+     for (int row = top; row <= bottom; row++) {
+	  for (int column = first; column <= last; column++) {
+	       if (m_dirty[row] & (1 << column)) {
+		    return true;
+	       }
+	  }
+     }
+
+     return false;
+}
@@ -0,0 +1,172 @@
+#ifndef SPRITE_H_
+#define SPRITE_H_
+
+class LCD;
+
+// Small image moved around the screen buffer, drawn with LCD::drawSprite
+// The bitmap is laid out like the ones of drawBitmap: rows of 8 pixels, column by column.
+// The optional mask has the same layout, with bits set where the sprite is opaque.
+// Drawing at a y that is not a multiple of 8 shifts every column down, which the sprite
+// can do once for all with preshift(), instead of on every draw.
+class Sprite
+{
+public:
+     // Raster operations combining the sprite with the screen buffer
+     // Pixels under the mask, if any, are cleared before the operation
+     enum raster_op {
+	  OP_OR = 0,       // Set the pixels of the sprite
+	  OP_AND_NOT = 1,  // Clear the pixels of the sprite
+	  OP_XOR = 2       // Invert the pixels of the sprite
+     };
+
+     // Create a sprite of width x height pixels from a bitmap, and a mask, in RAM
+     // The bitmap and mask are used as is and must outlive the sprite
+     Sprite(const char *bitmap, int width, int height, const char *mask = 0);
+
+     // Free the shifted copies if they were allocated by preshift
+     ~Sprite();
+
+     // Build the copies of the sprite shifted down by 0 to 7 pixels, in the given buffer
+     // of getPreshiftSize() bytes, or in an allocated one if 0. Returns false if out of memory.
+     bool preshift(char *buffer = 0);
+
+     // Returns the number of bytes taken by the shifted copies
+     int getPreshiftSize();
+
+     // Returns the width of the sprite in pixels
+     int getWidth();
+
+     // Returns the height of the sprite in pixels
+     int getHeight();
+
+     // Returns the height of the sprite in screen rows
+     int getRows();
+
+     // Get column x of row y of the sprite shifted down by shift pixels, and of its mask
+     // (0 if none), y going from 0 to getRows() (included for the part shifted out)
+     void getColumn(int x, int y, int shift, unsigned char &bits, unsigned char &mask);
+
+private:
+     // Copies are not allowed, the shifted copies belong to a single instance
+     Sprite(const Sprite &);
+     Sprite &operator=(const Sprite &);
+
+     // The sprite image, its mask and dimensions
+     const char *m_bitmap;
+     const char *m_mask;
+     int m_width;
+     int m_height;
+     int m_rows;
+
+     // The shifted copies, 0 if not preshifted
+     // Copy n holds getRows() + 1 rows of the bitmap, then as many of the mask if any
+     char *m_shifted;
+     bool m_ownshifted;
+
+     // Shift column x of row y of the source down by shift pixels
+     unsigned char shiftColumn(const char *source, int x, int y, int shift);
+};
+
+// Background of 8x8 pixel tiles, each one aligned to a screen row
+// The tiles are stored in program memory (PROGMEM), 8 columns per tile, and the map holds
+// the index of the tile at each place, row after row.
+class TileMap
+{
+public:
+     // Create a map of columns x rows tiles, the map stays owned by the caller
+     // The 84x48 screen takes 11 columns (the last one half shown) and 6 rows
+     TileMap(const char *tiles, unsigned char *map, int columns = 11, int rows = 6);
+
+     // Set the tile shown at the given place
+     void setTile(int column, int row, unsigned char tile);
+
+     // Returns the index of the tile shown at the given place, 0 if out of bounds
+     unsigned char getTile(int column, int row);
+
+     // Returns the columns of the tile shown at the given place in program memory
+     const char *getTileData(int column, int row);
+
+     // Returns the number of columns of tiles
+     int getColumns();
+
+     // Returns the number of rows of tiles
+     int getRows();
+
+private:
+     // The tile columns, and the map of tile indices
+     const char *m_tiles;
+     unsigned char *m_map;
+
+     // The map dimensions
+     int m_columns;
+     int m_rows;
+};
+
+// Sprites drawn over a tile map background
+// Each draw() only restores the tiles that the sprites left, or moved onto since the last
+// draw, and redraws the sprites over them, so still parts of the screen are not touched.
+class SpriteLayer
+{
+public:
+     // Create a layer of count sprites, all hidden, over the given background (blank if 0)
+     // Allocates the sprite slots; if that fails the layer has no slots.
+     SpriteLayer(TileMap *background = 0, int count = 12);
+
+     // Free the sprite slots
+     ~SpriteLayer();
+
+     // Set the sprite shown in slot index and the way it is drawn, slots are drawn in order
+     void setSprite(int index, Sprite *sprite, Sprite::raster_op op = Sprite::OP_OR);
+
+     // Move the sprite of slot index to (x, y), its top left corner
+     void move(int index, int x, int y);
+
+     // Show or hide the sprite of slot index
+     void show(int index, bool visible = true);
+
+     // Redraw the whole background and every sprite on the next draw, after the tile map
+     // changed or the screen buffer was drawn to
+     void invalidate();
+
+     // Draw the changes since the last draw to the screen buffer of the LCD
+     // The buffer is flushed at the end if the LCD flushes automatically.
+     void draw(LCD &lcd);
+
+private:
+     // Copies are not allowed, the sprite slots belong to a single instance
+     SpriteLayer(const SpriteLayer &);
+     SpriteLayer &operator=(const SpriteLayer &);
+
+     // A sprite, how it is drawn now, and how it was drawn last
+     struct Slot {
+	  Sprite *sprite;
+	  Sprite::raster_op op;
+	  int x;
+	  int y;
+	  bool visible;
+	  bool changed;
+	  int drawnX;
+	  int drawnY;
+	  int drawnWidth;
+	  int drawnHeight;
+	  bool drawn;
+     };
+
+     Slot *m_slots;
+     int m_count;
+
+     // The background
+     TileMap *m_background;
+
+     // The tiles to restore, bit c of row r set for tile column c
+     unsigned int m_dirty[6];
+
+     // Mark the tiles under the rectangle to be restored
+     // Returns true if any of them was not marked already
+     bool markTiles(int x, int y, int width, int height);
+
+     // Returns whether any tile under the rectangle is to be restored
+     bool isDirty(int x, int y, int width, int height);
+};
+
+#endif /* SPRITE_H_ */
@@ -0,0 +1,263 @@
+#include <Arduino.h>
+#include "Transport.h"
+
+void Transport::write(char byte, bool data)
+{
+     // A transfer of a single byte
+     select(data);
+     transfer(byte);
+     deselect();
+}
+
+void Transport::selectShared(bool data)
+{
+     // Enabling the chip takes nothing else
+     select(data);
+}
+
+void Transport::deselectShared()
+{
+     deselect();
+}
+
+bool Transport::transferAsync(const char *commands, int commandCount, const char *bytes, int count, Callback done, void *context)
+{
+     // Send the bytes right away, the command bytes first
+     if (commandCount > 0) {
+	  select(false);
+
+	  for (int i = 0; i < commandCount; i++) {
+	       transfer(commands[i]);
+	  }
+
+	  deselect();
+     }
+
+     select(true);
+
+     for (int i = 0; i < count; i++) {
+	  transfer(bytes[i]);
+     }
+
+     deselect();
+
+     done(context);
+
+     return true;
+}
+
+bool Transport::isBusy()
+{
+     // Transfers complete before returning
+     return false;
+}
+
+void Transport::wait()
+{
+     // Transfers complete before returning
+}
+
+BitBangTransport::BitBangTransport(int clock, int output, int type, int enable)
+{
+     // Initialize the pins of the transport
+     m_clock = clock;
+     m_output = output;
+     m_type = type;
+     m_enable = enable;
+}
+
+void BitBangTransport::begin()
+{
+     // Initialize the pins to low, except enable which is active LOW
+     pinMode(m_clock, OUTPUT);
+     digitalWrite(m_clock, LOW);
+
+     pinMode(m_output, OUTPUT);
+     digitalWrite(m_output, LOW);
+
+     pinMode(m_type, OUTPUT);
+     digitalWrite(m_type, LOW);
+
+     pinMode(m_enable, OUTPUT);
+     digitalWrite(m_enable, HIGH);
+}
+
+void BitBangTransport::select(bool data)
+{
+     // Set the chip to look for clock cycles
+     digitalWrite(m_enable, LOW);
+     // Set the byte type
+     digitalWrite(m_type, data ? HIGH : LOW);
+}
+
+void BitBangTransport::transfer(char byte)
+{
+     // Write the byte to the LCD screen, one bit at a time, starting with high bit
+     for (int i = 0; i < 8; i++, byte <<= 1) {
+	  digitalWrite(m_clock, LOW);
+	  digitalWrite(m_output, byte < 0 ? HIGH : LOW);
+	  digitalWrite(m_clock, HIGH);
+     }
+}
+
+void BitBangTransport::deselect()
+{
+     // Set the chip to ignore clock cycles
+     digitalWrite(m_enable, HIGH);
+}
+
+CaptureTransport::CaptureTransport(unsigned int *buffer, int size)
+{
+     // Initialize the buffer being recorded into
+     m_buffer = buffer;
+     m_size = size;
+
+     m_selected = false;
+     m_stepped = false;
+     m_asyncCommands = 0;
+     m_asyncCommandCount = 0;
+     m_async = 0;
+     m_asyncCount = 0;
+
+     reset();
+}
+
+void CaptureTransport::begin()
+{
+     // Nothing to set up
+}
+
+void CaptureTransport::select(bool data)
+{
+     // A real transport would wait for the asynchronous transfer to complete
+     wait();
+
+     // Remember the type of the bytes being transferred
+     m_selected = data;
+}
+
+void CaptureTransport::transfer(char byte)
+{
+     // Count the byte
+     if (m_selected) {
+	  m_data++;
+     }
+     else {
+	  m_commands++;
+     }
+
+     // Record the byte if there is room left
+     if (m_length < m_size) {
+	  m_buffer[m_length++] = (unsigned char) byte | (m_selected ? DATA_FLAG : 0);
+     }
+}
+
+void CaptureTransport::deselect()
+{
+     // Nothing to do at the end of a transfer
+}
+
+void CaptureTransport::setStepped(bool stepped)
+{
+     // Complete the transfer in progress before changing modes
+     wait();
+
+     m_stepped = stepped;
+}
+
+bool CaptureTransport::transferAsync(const char *commands, int commandCount, const char *bytes, int count, Callback done, void *context)
+{
+     if (!m_stepped) {
+	  return Transport::transferAsync(commands, commandCount, bytes, count, done, context);
+     }
+
+     if (m_async) {
+	  return false;
+     }
+
+     // Keep the transfer until it is stepped
+     m_asyncCommands = commands;
+     m_asyncCommandCount = commandCount;
+     m_async = bytes;
+     m_asyncCount = count;
+     m_done = done;
+     m_context = context;
+
+     return true;
+}
+
+bool CaptureTransport::isBusy()
+{
+     return m_async != 0;
+}
+
+void CaptureTransport::wait()
+{
+     // Step until the transfer, and the ones started by its callback, complete
+     while (m_async) {
+	  step(m_asyncCommandCount + m_asyncCount);
+     }
+}
+
+bool CaptureTransport::step(int count)
+{
+     if (!m_async) {
+	  return false;
+     }
+
+     // Record the next bytes, the command bytes first
+     m_selected = false;
+
+     for (; count > 0 && m_asyncCommandCount > 0; count--, m_asyncCommandCount--) {
+	  transfer(*m_asyncCommands++);
+     }
+
+     m_selected = true;
+
+     for (; count > 0 && m_asyncCount > 0; count--, m_asyncCount--) {
+	  transfer(*m_async++);
+     }
+
+     if (m_asyncCommandCount > 0 || m_asyncCount > 0) {
+	  return true;
+     }
+
+     // The transfer completed, the callback may start the next one
+     m_async = 0;
+     m_done(m_context);
+
+     return m_async != 0;
+}
+
+void CaptureTransport::reset()
+{
+     // Forget everything recorded
+     m_length = 0;
+     m_data = 0;
+     m_commands = 0;
+}
+
+int CaptureTransport::getLength()
+{
+     return m_length;
+}
+
+unsigned int CaptureTransport::getEntry(int index)
+{
+     // Return 0 if out of bounds
+     if (index < 0 || index >= m_length) {
+	  return 0;
+     }
+
+     return m_buffer[index];
+}
+
+long CaptureTransport::getDataCount()
+{
+     return m_data;
+}
+
+long CaptureTransport::getCommandCount()
+{
+     return m_commands;
+}
@@ -0,0 +1,157 @@
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+// Base class for the ways of sending bytes to the LCD screen controller
+// The LCD class only talks to the screen through a transport
+class Transport
+{
+public:
+     // Function called when an asynchronous transfer completes
+     typedef void (*Callback)(void *context);
+
+     // Set up the pins used by the transport, leaving the chip disabled
+     virtual void begin() = 0;
+
+     // Enable the chip for a transfer of data bytes, or command bytes
+     virtual void select(bool data) = 0;
+
+     // Send a single byte while the chip is enabled
+     virtual void transfer(char byte) = 0;
+
+     // Disable the chip at the end of a transfer
+     virtual void deselect() = 0;
+
+     // Enable the chip for the bytes another transport of the same kind clocks out on lines
+     // shared with this one, without taking the lines for a transfer of its own (LCDGroup)
+     // By default the same as select.
+     virtual void selectShared(bool data);
+
+     // Disable the chip enabled with selectShared, by default the same as deselect
+     virtual void deselectShared();
+
+     // Start sending commandCount command bytes, then count data bytes, in the background,
+     // calling done(context) when finished. The bytes must stay unchanged until then.
+     // Returns false if a transfer is in progress. By default the bytes are sent before returning.
+     virtual bool transferAsync(const char *commands, int commandCount, const char *bytes, int count, Callback done, void *context);
+
+     // Returns whether an asynchronous transfer is in progress
+     virtual bool isBusy();
+
+     // Wait for the asynchronous transfer in progress to complete
+     virtual void wait();
+
+     // Write a single byte to the LCD screen, as data or as a command
+     void write(char byte, bool data);
+};
+
+// Transport that clocks every bit out on general purpose pins
+// Works on any pins, used by the LCD(clock, output, type, enable, ...) constructor
+class BitBangTransport : public Transport
+{
+public:
+     // Create a bit-bang transport on the given pins
+     BitBangTransport(int clock = 2, int output = 3, int type = 4, int enable = 5);
+
+     // Set up the pins used by the transport, leaving the chip disabled
+     virtual void begin();
+
+     // Enable the chip for a transfer of data bytes, or command bytes
+     virtual void select(bool data);
+
+     // Send a single byte, one bit at a time, starting with the high bit
+     virtual void transfer(char byte);
+
+     // Disable the chip at the end of a transfer
+     virtual void deselect();
+
+private:
+     // The pins for this transport, initialized with the constructor
+     int m_clock;
+     int m_output;
+     int m_type;
+     int m_enable;
+};
+
+// Transport that records the bytes instead of sending them anywhere
+// Useful to check what the LCD class sends without a screen attached
+class CaptureTransport : public Transport
+{
+public:
+     // Create a capture transport recording into the given buffer of size entries
+     // Each entry holds the byte in the low 8 bits, and DATA_FLAG for data bytes
+     CaptureTransport(unsigned int *buffer, int size);
+
+     // Flag set on the entries of data bytes
+     static const unsigned int DATA_FLAG = 0x100;
+
+     // Nothing to set up
+     virtual void begin();
+
+     // Start recording bytes of the given type, completing any asynchronous transfer first
+     virtual void select(bool data);
+
+     // Record a single byte, counting it even when the buffer is full
+     virtual void transfer(char byte);
+
+     // Nothing to do at the end of a transfer
+     virtual void deselect();
+
+     // Record asynchronous transfers as they are stepped with step(), like an interrupt driven
+     // transport, instead of all at once
+     void setStepped(bool stepped = true);
+
+     // Start an asynchronous transfer, recorded right away unless stepped
+     virtual bool transferAsync(const char *commands, int commandCount, const char *bytes, int count, Callback done, void *context);
+
+     // Returns whether a stepped asynchronous transfer is in progress
+     virtual bool isBusy();
+
+     // Record the rest of the stepped asynchronous transfer in progress
+     virtual void wait();
+
+     // Record up to count bytes of the stepped asynchronous transfer in progress, the command
+     // bytes first, calling its callback when it completes. Returns whether a transfer is still
+     // in progress.
+     bool step(int count = 1);
+
+     // Forget the recorded bytes and reset the counters
+     void reset();
+
+     // Returns the number of entries recorded in the buffer
+     int getLength();
+
+     // Returns the recorded entry at the given index
+     unsigned int getEntry(int index);
+
+     // Returns the number of data bytes written since the last reset
+     long getDataCount();
+
+     // Returns the number of command bytes written since the last reset
+     long getCommandCount();
+
+private:
+     // The buffer being recorded into, and its size
+     unsigned int *m_buffer;
+     int m_size;
+
+     // The number of entries recorded
+     int m_length;
+
+     // Whether the bytes being transferred are data bytes
+     bool m_selected;
+
+     // The stepped asynchronous transfer in progress, its command bytes sent first
+     bool m_stepped;
+     const char *m_asyncCommands;
+     int m_asyncCommandCount;
+     const char *m_async;
+     int m_asyncCount;
+     Callback m_done;
+     void *m_context;
+
+     // The byte counters
+     long m_data;
+     long m_commands;
+};
+
+#endif /* TRANSPORT_H_ */